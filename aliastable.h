@@ -0,0 +1,61 @@
+﻿#ifndef ALIASTABLE_H
+#define ALIASTABLE_H
+
+#include <QVector>
+#include "gamerandom.h"
+
+// 按权重抽样的别名表（Vose 算法）
+// build 为 O(n)，sample 为 O(1)：随机选一格，再按该格的概率决定取自己还是别名。
+// 权重变化后重新 build 即可，抽样方不需要知道权重的总和。
+class AliasTable {
+public:
+    bool isEmpty() const { return m_prob.isEmpty(); }
+    int size() const { return m_prob.size(); }
+
+    // 权重须非负；全为 0 时按均匀分布处理
+    void build(const QVector<double>& weights) {
+        const int n = weights.size();
+        m_prob.resize(n);
+        m_alias.resize(n);
+        if (n == 0) return;
+
+        double total = 0.0;
+        for (double w : weights) total += w;
+
+        // 缩放到平均值为 1，分成不足 1 和超过 1 的两组，互相填补
+        QVector<double> scaled(n);
+        QVector<int> small, large;
+        small.reserve(n);
+        large.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            scaled[i] = total > 0.0 ? weights[i] * n / total : 1.0;
+            if (scaled[i] < 1.0) small.append(i);
+            else large.append(i);
+        }
+        while (!small.isEmpty() && !large.isEmpty()) {
+            int s = small.takeLast();
+            int l = large.last();
+            m_prob[s] = scaled[s];
+            m_alias[s] = l;
+            scaled[l] -= 1.0 - scaled[s];
+            if (scaled[l] < 1.0) {
+                large.removeLast();
+                small.append(l);
+            }
+        }
+        // 剩下的（包括浮点误差留下的）都是满格
+        for (int i : large) { m_prob[i] = 1.0; m_alias[i] = i; }
+        for (int i : small) { m_prob[i] = 1.0; m_alias[i] = i; }
+    }
+
+    int sample(GameRandom& rng) const {
+        int i = rng.bounded(m_prob.size());
+        return rng.generateDouble() < m_prob[i] ? i : m_alias[i];
+    }
+
+private:
+    QVector<double> m_prob;
+    QVector<int> m_alias;
+};
+
+#endif // ALIASTABLE_H
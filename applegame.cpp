@@ -1,270 +1,479 @@
-﻿#include "applegame.h"
-#include <QRandomGenerator>
-#include <QDebug>
-#include <QtMath>
-
-const int GAME_FPS = 60;
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
-
-AppleGame::AppleGame(QObject* parent) : GameBase(parent) {
-    m_bgPixmap.load(":/img/apple_background.png");
-    m_applePixmap.load(":/img/apple_normal.png");
-    m_basketPixmap.load(":/img/apple_basket.png");
-    m_appleBadPixmap.load(":/img/apple_bad.png");
-
-    m_catchSound = new QSoundEffect(this);
-    m_catchSound->setSource(QUrl::fromLocalFile(":/snd/apple_in.wav"));
-
-    m_bgMusic = new QSoundEffect(this);
-    m_bgMusic->setSource(QUrl::fromLocalFile(":/snd/apple_bg.wav"));
-    m_bgMusic->setLoopCount(QSoundEffect::Infinite);
-
-    m_physicsTimer = new QTimer(this);
-    m_physicsTimer->setInterval(1000 / GAME_FPS);
-    connect(m_physicsTimer, &QTimer::timeout, this, &AppleGame::onGameTick);
-}
-
-AppleGame::~AppleGame() {
-    qDeleteAll(m_apples);
-    m_apples.clear();
-}
-
-void AppleGame::updateSettings(const AppleSettingsData& settings) {
-    m_settings = settings;
-}
-
-void AppleGame::initGame() {
-    m_state = GameState::Ready;
-    m_score = 0;
-    m_caughtCount = 0;
-    m_lives = m_settings.failCount;
-
-    qDeleteAll(m_apples);
-    m_apples.clear();
-
-    m_basketPos = QPointF(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 80);
-
-    m_spawnTimer = 0;
-
-    m_spawnInterval = 60 - (m_settings.level - 1) * 4;
-    if (m_spawnInterval < 20) m_spawnInterval = 20; // 极限每0.3秒一波
-
-    // 基础速度: Level 0.5 -> 1.5, Level 10 -> 2.3
-    m_currentBaseSpeed = 0.5 + (m_settings.level - 1) * 0.2;
-
-    emit scoreChanged(0);
-}
-
-void AppleGame::startGame() {
-    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
-        initGame();
-        m_state = GameState::Playing;
-        m_physicsTimer->start();
-        m_bgMusic->play();
-    }
-}
-
-void AppleGame::pauseGame() {
-    if (m_state == GameState::Playing) {
-        m_state = GameState::Paused;
-        m_physicsTimer->stop();
-        m_bgMusic->stop();
-    }
-    else if (m_state == GameState::Paused) {
-        m_state = GameState::Playing;
-        m_physicsTimer->start();
-        m_bgMusic->play();
-    }
-}
-
-void AppleGame::stopGame() {
-    m_state = GameState::GameOver;
-    m_physicsTimer->stop();
-    m_bgMusic->stop();
-
-    qDeleteAll(m_apples);
-    m_apples.clear();
-}
-
-void AppleGame::onGameTick() {
-    // 胜利判定
-    if (m_caughtCount >= m_settings.targetCount) {
-        stopGame();
-        emit gameFinished(m_score, true);
-        return;
-    }
-
-    // 生成逻辑
-    m_spawnTimer++;
-    if (m_spawnTimer >= m_spawnInterval) {
-        int spawnCount = 1;
-
-        // 根据等级计算暴击概率 (1级0%, 3级20%, 10级90%)
-        int randomVal = QRandomGenerator::global()->bounded(100);
-        int extraChance = (m_settings.level - 1) * 10;
-
-        if (randomVal < extraChance) {
-            spawnCount++; // 变成 2 个
-        }
-        // 高等级(5级以上)才有可能出 3 个
-        if (m_settings.level >= 5 && randomVal < (extraChance - 40)) {
-            spawnCount++; // 变成 3 个
-        }
-
-        for (int i = 0; i < spawnCount; i++) {
-            spawnApple();
-        }
-
-        m_spawnTimer = 0;
-
-        // 设置极限值
-        int minInterval = 35;
-
-        // 减缓增速
-        if (m_spawnInterval > minInterval) {
-            if (QRandomGenerator::global()->bounded(10) == 0) {
-                m_spawnInterval--;
-            }
-        }
-    }
-
-    //更新物理
-    updateApples();
-}
-
-void AppleGame::spawnApple() {
-    // 随机X坐标
-    int margin = 60;
-    int x = QRandomGenerator::global()->bounded(margin, SCREEN_WIDTH - margin);
-
-    char letter = 'A' + QRandomGenerator::global()->bounded(26);
-
-    int yOffset = QRandomGenerator::global()->bounded(100); // 0~100 的偏移
-
-    double speedVariance = QRandomGenerator::global()->bounded(1.0); // 0~1.0 波动
-
-    Apple* apple = new Apple(QPointF(x, -50 - yOffset), m_currentBaseSpeed + speedVariance, QString(letter));
-    m_apples.append(apple);
-}
-
-void AppleGame::updateApples() {
-    for (Apple* apple : m_apples) {
-        if (!apple->active) continue;
-
-        // 如果已经是烂苹果，只处理停留计时
-        if (apple->isBad) {
-            apple->removeTimer--;
-            if (apple->removeTimer <= 0) {
-                apple->active = false; // 时间到，彻底移除
-            }
-            continue; // 烂苹果不移动，跳过移动逻辑
-        }
-
-        // 正常下落
-        apple->pos.setY(apple->pos.y() + apple->speed);
-
-        // 落地检测 
-        if (apple->pos.y() > 520) {
-            apple->isBad = true;
-            apple->removeTimer = 30; 
-
-            // 扣血逻辑
-            m_lives--;
-
-            if (m_lives <= 0) {
-                stopGame();
-                emit gameFinished(m_score, false);
-                return; // 防止崩溃
-            }
-        }
-    }
-
-    if (m_state != GameState::Playing) return;
-    for (auto it = m_apples.begin(); it != m_apples.end(); ) {
-        if (!(*it)->active) {
-            delete* it;
-            it = m_apples.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
-}
-
-void AppleGame::handleKeyPress(QKeyEvent* event) {
-    if (m_state != GameState::Playing) return;
-
-    QString text = event->text().toUpper();
-    if (text.isEmpty()) return;
-
-    Apple* target = nullptr;
-    double maxY = -1000.0;
-
-    // 优先消除离地面最近的
-    for (Apple* apple : m_apples) {
-        if (apple->active && apple->letter == text) {
-            if (apple->pos.y() > maxY) {
-                maxY = apple->pos.y();
-                target = apple;
-            }
-        }
-    }
-
-    if (target) {
-        target->active = false;
-        m_score += 10;
-        m_caughtCount++;
-        m_catchSound->play();
-        m_basketPos.setX(target->pos.x());
-
-        emit scoreChanged(m_score);
-    }
-}
-
-void AppleGame::draw(QPainter& painter) {
-    painter.setRenderHint(QPainter::Antialiasing);
-    if (!m_bgPixmap.isNull()) painter.drawPixmap(0, 0, m_bgPixmap);
-    else painter.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, QColor(135, 206, 235));
-
-    double basketY = SCREEN_HEIGHT - 80;
-    if (!m_basketPixmap.isNull()) painter.drawPixmap(m_basketPos.x() - m_basketPixmap.width() / 2, basketY, m_basketPixmap);
-    else { painter.setBrush(Qt::yellow); painter.drawRect(m_basketPos.x() - 40, basketY, 80, 40); }
-
-    // 绘制苹果
-    painter.setFont(QFont("Arial", 16, QFont::Bold));
-
-    for (Apple* apple : m_apples) {
-        if (!apple->active) continue;
-
-        if (apple->isBad) {
-            // 绘制烂苹果
-            if (!m_appleBadPixmap.isNull()) {
-                painter.drawPixmap(apple->pos.x() - m_appleBadPixmap.width() / 2,
-                    apple->pos.y() - m_appleBadPixmap.height() / 2,
-                    m_appleBadPixmap);
-            }
-        }
-        else {
-            // 绘制正常苹果
-            if (!m_applePixmap.isNull()) {
-                painter.drawPixmap(apple->pos.x() - m_applePixmap.width() / 2,
-                    apple->pos.y() - m_applePixmap.height() / 2,
-                    m_applePixmap);
-            }
-            // 绘制字母
-            painter.setPen(Qt::white);
-            QRect textRect(apple->pos.x() - 20, apple->pos.y() - 20, 40, 40);
-            painter.drawText(textRect, Qt::AlignCenter, apple->letter);
-        }
-    }
-
-    painter.setPen(Qt::black);
-    painter.setFont(QFont("Microsoft YaHei", 14, QFont::Bold));
-    QString lifeStr = QStringLiteral("生命: ");
-    painter.drawText(20, 40, lifeStr + QString::number(m_lives));
-    QString targetStr = QStringLiteral("目标: %1/%2").arg(m_caughtCount).arg(m_settings.targetCount);
-    painter.drawText(20, 70, targetStr);
-    QString scoreStr = QStringLiteral("得分: ");
-    painter.drawText(SCREEN_WIDTH - 150, 40, scoreStr + QString::number(m_score));
+﻿#include "applegame.h"
+#include "gametrace.h"
+#include "assetcache.h"
+#include "audiomixer.h"
+#include "contentgenerator.h"
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+
+const int GAME_FPS = 60;
+const double ENDLESS_RAMP = 4.0;  // 无尽模式：每过一秒，每秒多生成几个苹果
+const int GLYPH_SIZE = 40;        // 字母格子（逻辑像素），与苹果中心对齐
+
+AppleGame::AppleGame(QObject* parent) : GameBase(parent), m_glyphScale(0) {
+    m_bgPixmap.load(":/img/apple_background.png");
+    m_applePixmap.load(":/img/apple_normal.png");
+    m_basketPixmap.load(":/img/apple_basket.png");
+    m_appleBadPixmap.load(":/img/apple_bad.png");
+
+    m_catchSound = AudioMixer::instance().load(":/snd/apple_in.wav");
+
+
+    m_physicsTimer = new QTimer(this);
+    m_physicsTimer->setInterval(1000 / GAME_FPS);
+    connect(m_physicsTimer, &QTimer::timeout, this, &AppleGame::onGameTick);
+
+    resetLetterIndex();
+}
+
+AppleGame::~AppleGame() {
+}
+
+void AppleGame::updateSettings(const AppleSettingsData& settings) {
+    m_settings = settings;
+}
+
+const GameCapabilities& AppleGame::capabilities() const {
+    static const GameCapabilities caps = [] {
+        GameCapabilities c;
+        c.resultTheme = QStringLiteral("apple");
+        c.supportsSnapshots = true;
+        return c;
+    }();
+    return caps;
+}
+
+GameBase::SettingsResult AppleGame::execSettings(QWidget* parent) {
+    if (!m_settingsDialog) m_settingsDialog = new AppleGameSettings(parent);
+
+    AppleSettingsData oldSettings = m_settingsDialog->getSettings();
+    if (TRACE_EXEC(*m_settingsDialog, "AppleGameSettings::exec") != QDialog::Accepted) return SettingsRejected;
+
+    m_pendingSettings = m_settingsDialog->getSettings();
+    bool changed = (oldSettings.level != m_pendingSettings.level) ||
+        (oldSettings.targetCount != m_pendingSettings.targetCount) ||
+        (oldSettings.failCount != m_pendingSettings.failCount) ||
+        (oldSettings.endless != m_pendingSettings.endless);
+    return changed ? SettingsChanged : SettingsUnchanged;
+}
+
+void AppleGame::initGame() {
+    m_state = GameState::Ready;
+    m_score = 0;
+    m_caughtCount = 0;
+    m_lives = m_settings.failCount;
+
+    m_apples.clear();
+    resetLetterIndex();
+
+    m_elapsedTicks = 0;
+    m_endlessSpawnCredit = 0.0;
+    m_missedCount = 0;
+
+    m_basketPos = QPointF(SCREEN_WIDTH / 2, SCREEN_HEIGHT - 80);
+
+    m_spawnTimer = 0;
+    m_lastLetter = 0;
+
+    m_spawnInterval = 60 - (m_settings.level - 1) * 4;
+    if (m_spawnInterval < 20) m_spawnInterval = 20; // 极限每0.3秒一波
+
+    // 基础速度: Level 0.5 -> 1.5, Level 10 -> 2.3
+    m_currentBaseSpeed = 0.5 + (m_settings.level - 1) * 0.2;
+
+    emit scoreChanged(0);
+}
+
+void AppleGame::startGame() {
+    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
+        initGame();
+        m_state = GameState::Playing;
+        beginSession();
+        m_physicsTimer->start();
+        AudioMixer::instance().playMusic(":/snd/apple_bg.wav");
+    }
+}
+
+void AppleGame::pauseGame() {
+    if (m_state == GameState::Playing) {
+        m_state = GameState::Paused;
+        pauseSession();
+        m_physicsTimer->stop();
+        AudioMixer::instance().stopMusic();
+    }
+    else if (m_state == GameState::Paused) {
+        m_state = GameState::Playing;
+        resumeSession();
+        m_physicsTimer->start();
+        AudioMixer::instance().playMusic(":/snd/apple_bg.wav");
+    }
+}
+
+void AppleGame::stopGame() {
+    m_state = GameState::GameOver;
+    m_physicsTimer->stop();
+    AudioMixer::instance().stopMusic();
+
+    m_apples.clear();
+    resetLetterIndex();
+}
+
+void AppleGame::resetLetterIndex() {
+    m_letterIndex.clear();
+    std::fill(m_lowest, m_lowest + LetterIndex<AppleHandle>::LetterCount, AppleHandle());
+    std::fill(m_runnerUp, m_runnerUp + LetterIndex<AppleHandle>::LetterCount, AppleHandle());
+}
+
+void AppleGame::refreshLowest(int bucket) {
+    AppleHandle lowest, runnerUp;
+    double lowestY = 0.0, runnerUpY = 0.0;
+    for (const AppleHandle& handle : m_letterIndex.bucket(bucket)) {
+        const Apple* apple = m_apples.get(handle);
+        if (!apple) continue;
+        if (lowest.isNull() || apple->pos.y() > lowestY) {
+            runnerUp = lowest;
+            runnerUpY = lowestY;
+            lowest = handle;
+            lowestY = apple->pos.y();
+        }
+        else if (runnerUp.isNull() || apple->pos.y() > runnerUpY) {
+            runnerUp = handle;
+            runnerUpY = apple->pos.y();
+        }
+    }
+    m_lowest[bucket] = lowest;
+    m_runnerUp[bucket] = runnerUp;
+}
+
+void AppleGame::saveState(QDataStream& out) const {
+    out << m_settings.level << m_settings.targetCount << m_settings.failCount << m_settings.endless
+        << m_basketPos << m_spawnTimer << qint8(m_lastLetter) << m_spawnInterval << m_currentBaseSpeed
+        << m_lives << m_caughtCount << m_elapsedTicks << m_endlessSpawnCredit << m_missedCount;
+
+    // 只写存活的苹果（本帧接住、尚未 compact 的不算），句柄恢复时重新生成
+    qint32 count = 0;
+    for (int i = 0; i < m_apples.size(); ++i) {
+        if (m_apples.isAlive(i)) count++;
+    }
+    out << count;
+    for (int i = 0; i < m_apples.size(); ++i) {
+        if (!m_apples.isAlive(i)) continue;
+        const Apple& apple = m_apples[i];
+        out << apple.pos << apple.speed << qint8(apple.letter) << apple.isBad << apple.removeTimer;
+    }
+}
+
+bool AppleGame::restoreState(QDataStream& in) {
+    // 设置先读到局部变量，全部校验通过后才生效；失败时 initGame 复位的是其余状态
+    AppleSettingsData settings;
+    qint8 lastLetter;
+    qint32 count;
+    in >> settings.level >> settings.targetCount >> settings.failCount >> settings.endless
+        >> m_basketPos >> m_spawnTimer >> lastLetter >> m_spawnInterval >> m_currentBaseSpeed
+        >> m_lives >> m_caughtCount >> m_elapsedTicks >> m_endlessSpawnCredit >> m_missedCount >> count;
+    if (in.status() != QDataStream::Ok || count < 0) return false;
+    if (settings.level < 1 || settings.targetCount < 1 || settings.failCount < 1) return false;
+    m_lastLetter = lastLetter;
+
+    m_apples.clear();
+    resetLetterIndex();
+    m_apples.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        QPointF pos;
+        double speed;
+        qint8 letter;
+        bool isBad;
+        int removeTimer;
+        in >> pos >> speed >> letter >> isBad >> removeTimer;
+        if (in.status() != QDataStream::Ok || LetterIndex<AppleHandle>::bucketOf(letter) < 0) return false;
+
+        Apple apple(pos, speed, letter);
+        apple.isBad = isBad;
+        apple.removeTimer = removeTimer;
+        AppleHandle handle = m_apples.add(apple);
+        if (!isBad) m_letterIndex.insert(letter, handle);
+    }
+    for (int b = 0; b < LetterIndex<AppleHandle>::LetterCount; ++b) refreshLowest(b);
+
+    m_settings = settings;
+    m_state = GameState::Paused;
+    m_physicsTimer->stop();
+    AudioMixer::instance().stopMusic();
+    return true;
+}
+
+void AppleGame::onGameTick() {
+    TRACE_SCOPE("AppleGame::onGameTick");
+    // 胜利判定（无尽模式没有终点）
+    if (!m_settings.endless && m_caughtCount >= m_settings.targetCount) {
+        stopGame();
+        emit gameFinished(m_score, true);
+        return;
+    }
+
+    m_elapsedTicks++;
+    if (m_settings.endless) {
+        // 每秒生成 (1 + 已过秒数 * ENDLESS_RAMP) 个，持续增长直到屏幕上有成千上万个
+        m_endlessSpawnCredit += (1.0 + ENDLESS_RAMP * m_elapsedTicks / GAME_FPS) / GAME_FPS * m_difficultyParams.spawnRate;
+        while (m_endlessSpawnCredit >= 1.0) {
+            spawnApple();
+            m_endlessSpawnCredit -= 1.0;
+        }
+        updateApples();
+        return;
+    }
+
+    // 生成逻辑
+    m_spawnTimer++;
+    if (m_spawnTimer >= scaledInterval(m_spawnInterval)) {
+        int spawnCount = 1;
+
+        // 根据等级计算暴击概率 (1级0%, 3级20%, 10级90%)
+        int randomVal = m_rng.bounded(100);
+        int extraChance = (m_settings.level - 1) * 10;
+
+        if (randomVal < extraChance) {
+            spawnCount++; // 变成 2 个
+        }
+        // 高等级(5级以上)才有可能出 3 个
+        if (m_settings.level >= 5 && randomVal < (extraChance - 40)) {
+            spawnCount++; // 变成 3 个
+        }
+
+        for (int i = 0; i < spawnCount; i++) {
+            spawnApple();
+        }
+
+        m_spawnTimer = 0;
+
+        // 设置极限值
+        int minInterval = 35;
+
+        // 减缓增速
+        if (m_spawnInterval > minInterval) {
+            if (m_rng.bounded(10) == 0) {
+                m_spawnInterval--;
+            }
+        }
+    }
+
+    //更新物理
+    updateApples();
+}
+
+void AppleGame::spawnApple() {
+    // 随机X坐标
+    int margin = 60;
+    int x = m_rng.bounded(margin, SCREEN_WIDTH - margin);
+
+    char letter = ContentGenerator::instance().letter(m_rng, m_lastLetter);
+    m_lastLetter = letter;
+
+    int yOffset = m_rng.bounded(100); // 0~100 的偏移
+
+    double speedVariance = m_rng.bounded(1.0); // 0~1.0 波动
+
+    QPointF pos(x, -50 - yOffset);
+    double speed = scaledSpeed(m_currentBaseSpeed + speedVariance);
+    AppleHandle handle = m_apples.add(Apple(pos, speed, letter));
+
+    m_letterIndex.insert(letter, handle);
+    int bucket = LetterIndex<AppleHandle>::bucketOf(letter);
+    const Apple* lowest = m_apples.get(m_lowest[bucket]);
+    const Apple* runnerUp = m_apples.get(m_runnerUp[bucket]);
+    if (!lowest || pos.y() > lowest->pos.y()) {
+        m_runnerUp[bucket] = m_lowest[bucket];
+        m_lowest[bucket] = handle;
+    }
+    else if (!runnerUp || pos.y() > runnerUp->pos.y()) {
+        m_runnerUp[bucket] = handle;
+    }
+}
+
+void AppleGame::updateApples() {
+    // 先记下标，循环结束后再换成句柄
+    int lowest[LetterIndex<AppleHandle>::LetterCount];
+    int runnerUp[LetterIndex<AppleHandle>::LetterCount];
+    std::fill(lowest, lowest + LetterIndex<AppleHandle>::LetterCount, -1);
+    std::fill(runnerUp, runnerUp + LetterIndex<AppleHandle>::LetterCount, -1);
+
+    for (int i = 0; i < m_apples.size(); ++i) {
+        Apple* apple = &m_apples[i];
+        if (!apple->active) continue;
+
+        // 如果已经是烂苹果，只处理停留计时
+        if (apple->isBad) {
+            apple->removeTimer--;
+            if (apple->removeTimer <= 0) {
+                apple->active = false; // 时间到，彻底移除
+                m_apples.killAt(i);
+            }
+            continue; // 烂苹果不移动，跳过移动逻辑
+        }
+
+        // 正常下落
+        apple->pos.setY(apple->pos.y() + apple->speed);
+
+        // 落地检测 
+        if (apple->pos.y() > 520) {
+            apple->isBad = true;
+            apple->removeTimer = 30; 
+            m_letterIndex.remove(apple->letter, m_apples.handleAt(i)); // 摔烂了就不能再接
+
+            // 扣血逻辑（无尽模式只计数）
+            if (m_settings.endless) {
+                m_missedCount++;
+                continue;
+            }
+            m_lives--;
+
+            if (m_lives <= 0) {
+                stopGame();
+                emit gameFinished(m_score, false);
+                return; // 防止崩溃
+            }
+            continue;
+        }
+
+        int bucket = LetterIndex<AppleHandle>::bucketOf(apple->letter);
+        if (bucket < 0) continue;
+        if (lowest[bucket] < 0 || apple->pos.y() > m_apples[lowest[bucket]].pos.y()) {
+            runnerUp[bucket] = lowest[bucket];
+            lowest[bucket] = i;
+        }
+        else if (runnerUp[bucket] < 0 || apple->pos.y() > m_apples[runnerUp[bucket]].pos.y()) {
+            runnerUp[bucket] = i;
+        }
+    }
+
+    if (m_state != GameState::Playing) return;
+    for (int b = 0; b < LetterIndex<AppleHandle>::LetterCount; ++b) {
+        m_lowest[b] = lowest[b] >= 0 ? m_apples.handleAt(lowest[b]) : AppleHandle();
+        m_runnerUp[b] = runnerUp[b] >= 0 ? m_apples.handleAt(runnerUp[b]) : AppleHandle();
+    }
+    // 本帧移除的苹果与末尾交换，句柄保持有效
+    m_apples.compact();
+}
+
+void AppleGame::handleKeyPress(QKeyEvent* event) {
+    if (m_state != GameState::Playing) return;
+
+    int bucket = LetterIndex<AppleHandle>::bucketOf(event);
+    if (bucket < 0) return;
+
+    // 优先消除离地面最近的
+    AppleHandle handle = m_lowest[bucket];
+    Apple* target = m_apples.get(handle);
+    const QChar actual('A' + bucket);
+    // 按错（场上没有这个字母）时记在离地面最近的苹果上，那才是玩家该按的键
+    const Apple* expected = target;
+    if (!expected) {
+        for (int b = 0; b < LetterIndex<AppleHandle>::LetterCount; ++b) {
+            const Apple* apple = m_apples.get(m_lowest[b]);
+            if (apple && (!expected || apple->pos.y() > expected->pos.y())) expected = apple;
+        }
+    }
+    reportKeystroke(expected ? QChar(expected->letter) : QChar(), actual);
+
+    if (target) {
+        target->active = false;
+        m_apples.kill(handle);
+        m_letterIndex.remove(target->letter, handle);
+        // 次低的顶上；它也已经不在了（同一帧接了两个同字母）才重新扫描
+        const Apple* next = m_apples.get(m_runnerUp[bucket]);
+        if (next && next->active && !next->isBad) {
+            m_lowest[bucket] = m_runnerUp[bucket];
+            m_runnerUp[bucket] = AppleHandle();
+        }
+        else {
+            refreshLowest(bucket);
+        }
+        m_score += 10;
+        m_caughtCount++;
+        AudioMixer::instance().play(m_catchSound);
+        m_basketPos.setX(target->pos.x());
+
+        emit scoreChanged(m_score);
+    }
+}
+
+void AppleGame::ensureGlyphAtlas() {
+    const qreal scale = AssetCache::instance().scale();
+    if (!m_glyphAtlas.isNull() && qFuzzyCompare(scale, m_glyphScale)) return;
+
+    // 26 个字母横向排成一张图，物理像素按当前比例，绘制时像素一一对应
+    const int frame = qCeil(GLYPH_SIZE * scale);
+    QPixmap atlas(frame * LetterIndex<AppleHandle>::LetterCount, frame);
+    atlas.fill(Qt::transparent);
+    atlas.setDevicePixelRatio(frame / (qreal)GLYPH_SIZE);
+
+    QPainter p(&atlas);
+    p.setRenderHint(QPainter::TextAntialiasing);
+    p.setFont(QFont("Arial", 16, QFont::Bold));
+    p.setPen(Qt::white);
+    for (int i = 0; i < LetterIndex<AppleHandle>::LetterCount; ++i) {
+        p.drawText(QRect(i * GLYPH_SIZE, 0, GLYPH_SIZE, GLYPH_SIZE), Qt::AlignCenter, QString(QChar('A' + i)));
+    }
+    p.end();
+
+    m_glyphAtlas = atlas;
+    m_glyphScale = scale;
+}
+
+void AppleGame::draw(QPainter& painter) {
+    TRACE_SCOPE("AppleGame::draw");
+    painter.setRenderHint(QPainter::Antialiasing);
+    AssetCache& assets = AssetCache::instance();
+    if (!m_bgPixmap.isNull()) painter.drawPixmap(0, 0, assets.scaled(m_bgPixmap));
+    else painter.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, QColor(135, 206, 235));
+
+    double basketY = SCREEN_HEIGHT - 80;
+    if (!m_basketPixmap.isNull()) painter.drawPixmap(m_basketPos.x() - m_basketPixmap.width() / 2, basketY, assets.scaled(m_basketPixmap));
+    else { painter.setBrush(Qt::yellow); painter.drawRect(m_basketPos.x() - 40, basketY, 80, 40); }
+
+    // 绘制苹果：同一贴图的苹果收集后一次提交，字母用预渲染图集
+    ensureGlyphAtlas();
+    m_appleBatch.setPixmap(assets.scaled(m_applePixmap));
+    m_badAppleBatch.setPixmap(assets.scaled(m_appleBadPixmap));
+    m_glyphBatch.setPixmap(m_glyphAtlas, LetterIndex<AppleHandle>::LetterCount);
+
+    // 还在屏幕上方（生成时的 yOffset）的苹果整个不可见，直接跳过
+    const double cullY = -qMax(m_applePixmap.height(), GLYPH_SIZE) / 2.0;
+
+    for (const Apple& apple : m_apples) {
+        if (!apple.active) continue;
+
+        if (apple.isBad) {
+            // 绘制烂苹果
+            m_badAppleBatch.addCentered(apple.pos);
+        }
+        else {
+            if (apple.pos.y() < cullY) continue;
+            // 绘制正常苹果
+            m_appleBatch.addCentered(apple.pos);
+            // 绘制字母
+            int glyph = LetterIndex<AppleHandle>::bucketOf(apple.letter);
+            if (glyph >= 0) m_glyphBatch.add((int)apple.pos.x() - GLYPH_SIZE / 2, (int)apple.pos.y() - GLYPH_SIZE / 2, glyph);
+        }
+    }
+
+    m_badAppleBatch.flush(painter);
+    m_appleBatch.flush(painter);
+    m_glyphBatch.flush(painter);
+
+    painter.setPen(Qt::black);
+    painter.setFont(QFont("Microsoft YaHei", 14, QFont::Bold));
+    if (m_settings.endless) {
+        painter.drawText(20, 40, QStringLiteral("漏接: %1").arg(m_missedCount));
+        painter.drawText(20, 70, QStringLiteral("场上: %1").arg(m_apples.size()));
+    }
+    else {
+        QString lifeStr = QStringLiteral("生命: ");
+        painter.drawText(20, 40, lifeStr + QString::number(m_lives));
+        QString targetStr = QStringLiteral("目标: %1/%2").arg(m_caughtCount).arg(m_settings.targetCount);
+        painter.drawText(20, 70, targetStr);
+    }
+    QString scoreStr = QStringLiteral("得分: ");
+    painter.drawText(SCREEN_WIDTH - 150, 40, scoreStr + QString::number(m_score));
 }
\ No newline at end of file
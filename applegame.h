@@ -1,66 +1,105 @@
-﻿#ifndef APPLEGAME_H
-#define APPLEGAME_H
-
-#include "gamebase.h"
-#include "applegamesettings.h"
-#include <QPixmap>
-#include <QList>
-#include <QPointF>
-#include <QtMultimedia/QSoundEffect>
-
-struct Apple {
-    QPointF pos;
-    double speed;
-    QString letter;
-    bool active;
-
-    // 落地状态
-    bool isBad;      // 是否已经摔烂
-    int removeTimer; // 摔烂后停留的帧数
-
-    Apple(QPointF p, double s, QString l)
-        : pos(p), speed(s), letter(l), active(true), isBad(false), removeTimer(0) {
-    }
-};
-
-class AppleGame : public GameBase {
-    Q_OBJECT
-        
-public:
-    explicit AppleGame(QObject* parent = nullptr);
-    ~AppleGame();
-    void initGame() override;
-    void startGame() override;
-    void pauseGame() override;
-    void stopGame() override;
-    void draw(QPainter& painter) override;
-    void handleKeyPress(QKeyEvent* event) override;
-    void updateSettings(const AppleSettingsData& settings);
-
-private slots:
-    void onGameTick();
-
-private:
-    void spawnApple();
-    void updateApples();
-
-    // 资源
-    QPixmap m_bgPixmap;
-    QPixmap m_applePixmap;
-    QPixmap m_appleBadPixmap; // 烂苹果图片
-    QPixmap m_basketPixmap;
-
-    QSoundEffect* m_catchSound;
-    QSoundEffect* m_bgMusic;
-    QList<Apple*> m_apples;
-    QPointF m_basketPos;
-    QTimer* m_physicsTimer;
-    int m_spawnTimer;
-    int m_spawnInterval;
-    double m_currentBaseSpeed;
-    int m_lives;
-    int m_caughtCount;
-    AppleSettingsData m_settings;
-};
-
+﻿#ifndef APPLEGAME_H
+#define APPLEGAME_H
+
+#include "gamecore_global.h"
+#include "gamebase.h"
+#include "applegamesettings.h"
+#include "letterindex.h"
+#include "spritebatch.h"
+#include "entitypool.h"
+#include <QPixmap>
+#include <QVector>
+#include <QPointF>
+
+struct Apple {
+    QPointF pos;
+    double speed;
+    char letter;     // 'A'-'Z'
+    bool active;
+
+    // 落地状态
+    bool isBad;      // 是否已经摔烂
+    int removeTimer; // 摔烂后停留的帧数
+
+    Apple(QPointF p, double s, char l)
+        : pos(p), speed(s), letter(l), active(true), isBad(false), removeTimer(0) {
+    }
+};
+
+typedef EntityPool<Apple>::Handle AppleHandle;
+
+class GAMECORE_EXPORT AppleGame : public GameBase {
+    Q_OBJECT
+        
+public:
+    explicit AppleGame(QObject* parent = nullptr);
+    ~AppleGame();
+    void initGame() override;
+    void startGame() override;
+    void pauseGame() override;
+    void stopGame() override;
+    void draw(QPainter& painter) override;
+    void handleKeyPress(QKeyEvent* event) override;
+    QString gameId() const override { return QStringLiteral("apple"); }
+    int difficulty() const override { return m_settings.level; }
+    const GameCapabilities& capabilities() const override;
+    SettingsResult execSettings(QWidget* parent) override;
+    void applySettings() override { updateSettings(m_pendingSettings); }
+    void updateSettings(const AppleSettingsData& settings);
+
+protected:
+    void saveState(QDataStream& out) const override;
+    bool restoreState(QDataStream& in) override;
+
+private slots:
+    void onGameTick();
+
+private:
+    friend class BenchAccess; // 基准测试直接构造内部状态
+
+    void spawnApple();
+    void updateApples();
+    void ensureGlyphAtlas();     // 按当前缩放比例预渲染 A-Z 字母图集
+    void resetLetterIndex();
+    void refreshLowest(int bucket); // 重新找出该字母最低（y 最大）和次低的苹果
+
+    // 资源
+    QPixmap m_bgPixmap;
+    QPixmap m_applePixmap;
+    QPixmap m_appleBadPixmap; // 烂苹果图片
+    QPixmap m_basketPixmap;
+
+    int m_catchSound;   // AudioMixer 音效 id
+    EntityPool<Apple> m_apples; // 移除后的空间留给新苹果复用
+    // 还在下落、可以被接住的苹果按字母分桶；m_lowest 是每个字母 y 最大的那个，
+    // m_runnerUp 是次低的。每帧移动时顺带更新，按键时直接取用；
+    // 接住最低的之后次低的顶上，同一帧里同一个字母接第二个时才重新扫描这个桶
+    LetterIndex<AppleHandle> m_letterIndex;
+    AppleHandle m_lowest[LetterIndex<AppleHandle>::LetterCount];
+    AppleHandle m_runnerUp[LetterIndex<AppleHandle>::LetterCount];
+    QPointF m_basketPos;
+    QTimer* m_physicsTimer;
+    int m_spawnTimer;
+    char m_lastLetter; // 上一个生成的字母，用于字母组合加权
+    int m_spawnInterval;
+    double m_currentBaseSpeed;
+    int m_lives;
+    int m_caughtCount;
+    AppleSettingsData m_settings;
+    AppleGameSettings* m_settingsDialog = nullptr; // 第一次打开设置时创建
+    AppleSettingsData m_pendingSettings;
+
+    // 无尽模式：生成速度随时间线性增长，没有上限
+    int m_elapsedTicks;
+    double m_endlessSpawnCredit; // 累积的待生成数量（小数部分留到下一帧）
+    int m_missedCount;
+
+    // 批量绘制：苹果、烂苹果和字母各一次提交
+    SpriteBatch m_appleBatch;
+    SpriteBatch m_badAppleBatch;
+    SpriteBatch m_glyphBatch;
+    QPixmap m_glyphAtlas;
+    qreal m_glyphScale;
+};
+
 #endif // APPLEGAME_H
\ No newline at end of file
@@ -0,0 +1,38 @@
+﻿#include "assetcache.h"
+
+// 贴图被重新加载后旧条目不会再命中，超过上限时整体清空即可
+const int ASSET_CACHE_LIMIT = 512;
+
+AssetCache& AssetCache::instance() {
+    static AssetCache instance;
+    return instance;
+}
+
+void AssetCache::setScale(qreal scale) {
+    if (scale <= 0.0 || qFuzzyCompare(scale, m_scale)) return;
+    m_scale = scale;
+    m_cache.clear();
+}
+
+QPixmap AssetCache::fitted(const QPixmap& src, const QSize& size, qreal ratio) {
+    if (src.isNull() || size.isEmpty()) return src;
+
+    QSize target(qRound(size.width() * ratio), qRound(size.height() * ratio));
+    // 原生尺寸直接返回，不占缓存
+    if (target == src.size() && qFuzzyCompare(ratio, src.devicePixelRatio())) return src;
+
+    Key key;
+    key.cacheKey = src.cacheKey();
+    key.size = size;
+    key.ratio = ratio;
+
+    QHash<Key, QPixmap>::const_iterator it = m_cache.constFind(key);
+    if (it != m_cache.constEnd()) return it.value();
+
+    if (m_cache.size() >= ASSET_CACHE_LIMIT) m_cache.clear();
+
+    QPixmap result = src.scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+    result.setDevicePixelRatio(ratio);
+    m_cache.insert(key, result);
+    return result;
+}
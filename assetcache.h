@@ -0,0 +1,52 @@
+﻿#ifndef ASSETCACHE_H
+#define ASSETCACHE_H
+
+#include "gamecore_global.h"
+#include <QHash>
+#include <QPixmap>
+#include <QSize>
+
+// 预缩放贴图缓存
+// 游戏统一在 800x600 的逻辑坐标系中绘制，窗口实际尺寸（以及屏幕 DPI）
+// 决定一个缩放比例。每张贴图按当前比例只缩放一次并缓存，绘制时像素一一对应，
+// 不会每帧重新采样；比例变化（窗口尺寸改变）时整体失效重建。
+class GAMECORE_EXPORT AssetCache {
+public:
+    static AssetCache& instance();
+
+    // 逻辑像素 -> 物理像素的比例，由 GameWidget 在尺寸变化时设置
+    void setScale(qreal scale);
+    qreal scale() const { return m_scale; }
+
+    // 按当前比例缩放，绘制尺寸保持为贴图原始尺寸
+    QPixmap scaled(const QPixmap& src) { return fitted(src, src.size(), m_scale); }
+    // 按当前比例缩放，绘制尺寸为 size（逻辑像素）
+    QPixmap scaled(const QPixmap& src, const QSize& size) { return fitted(src, size, m_scale); }
+
+    // 生成 size × ratio 物理像素的副本，devicePixelRatio 设为 ratio，
+    // 因此用 drawPixmap 以 size 的逻辑尺寸绘制时恰好不需要再缩放
+    QPixmap fitted(const QPixmap& src, const QSize& size, qreal ratio);
+
+    void clear() { m_cache.clear(); }
+
+private:
+    AssetCache() : m_scale(1.0) {}
+
+    struct Key {
+        qint64 cacheKey;
+        QSize size;
+        qreal ratio;
+        bool operator==(const Key& o) const {
+            return cacheKey == o.cacheKey && size == o.size && qFuzzyCompare(ratio, o.ratio);
+        }
+    };
+    friend uint qHash(const Key& key, uint seed) {
+        return qHash(key.cacheKey, seed) ^ qHash(key.size.width() * 31 + key.size.height(), seed)
+            ^ qHash(qRound(key.ratio * 1000), seed);
+    }
+
+    qreal m_scale;
+    QHash<Key, QPixmap> m_cache;
+};
+
+#endif // ASSETCACHE_H
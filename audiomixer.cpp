@@ -0,0 +1,415 @@
+﻿#include "audiomixer.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QScopedPointer>
+#include <QtEndian>
+#include <QtMultimedia/QAudioDeviceInfo>
+#include <QtMultimedia/QAudioOutput>
+#include <QDebug>
+#include <cstring>
+#include <cmath>
+
+namespace {
+
+// WAV 文件头中与解码有关的字段
+struct WavFormat {
+    int format = 0;        // 1 = PCM 整数, 3 = IEEE 浮点
+    int channels = 0;
+    int sampleRate = 0;
+    int bitsPerSample = 0;
+    int blockAlign = 0;
+    qint64 dataOffset = 0;
+    qint64 dataSize = 0;
+};
+
+const int WAVE_FORMAT_PCM = 1;
+const int WAVE_FORMAT_IEEE_FLOAT = 3;
+const int WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+bool readWavHeader(QIODevice& dev, WavFormat& wav) {
+    QByteArray riff = dev.read(12);
+    if (riff.size() < 12 || !riff.startsWith("RIFF") || riff.mid(8, 4) != "WAVE") return false;
+
+    bool haveFmt = false;
+    while (!dev.atEnd()) {
+        QByteArray chunk = dev.read(8);
+        if (chunk.size() < 8) break;
+        quint32 size = qFromLittleEndian<quint32>(chunk.constData() + 4);
+
+        if (chunk.startsWith("fmt ")) {
+            QByteArray fmt = dev.read(size);
+            if (fmt.size() < 16) return false;
+            const char* p = fmt.constData();
+            wav.format = qFromLittleEndian<quint16>(p);
+            wav.channels = qFromLittleEndian<quint16>(p + 2);
+            wav.sampleRate = (int)qFromLittleEndian<quint32>(p + 4);
+            wav.blockAlign = qFromLittleEndian<quint16>(p + 12);
+            wav.bitsPerSample = qFromLittleEndian<quint16>(p + 14);
+            // WAVE_FORMAT_EXTENSIBLE：真正的格式在 SubFormat GUID 的前两个字节
+            if (wav.format == WAVE_FORMAT_EXTENSIBLE && fmt.size() >= 26) {
+                wav.format = qFromLittleEndian<quint16>(p + 24);
+            }
+            if (size & 1) dev.read(1);
+            haveFmt = true;
+        }
+        else if (chunk.startsWith("data")) {
+            wav.dataOffset = dev.pos();
+            wav.dataSize = qMin<qint64>(size, dev.size() - wav.dataOffset);
+            break;
+        }
+        else if (!dev.seek(dev.pos() + size + (size & 1))) {
+            return false;
+        }
+    }
+
+    if (!haveFmt || wav.dataSize <= 0) return false;
+    if (wav.channels < 1 || wav.sampleRate <= 0) return false;
+    if (wav.blockAlign != wav.channels * wav.bitsPerSample / 8) return false;
+    if (wav.format == WAVE_FORMAT_PCM) {
+        return wav.bitsPerSample == 8 || wav.bitsPerSample == 16
+            || wav.bitsPerSample == 24 || wav.bitsPerSample == 32;
+    }
+    return wav.format == WAVE_FORMAT_IEEE_FLOAT && wav.bitsPerSample == 32;
+}
+
+// 单个采样转成 [-1, 1] 的浮点数
+inline float sampleToFloat(const uchar* p, const WavFormat& wav) {
+    switch (wav.bitsPerSample) {
+    case 8:
+        return (p[0] - 128) / 128.0f; // 8 位 WAV 是无符号的
+    case 16:
+        return qFromLittleEndian<qint16>(p) / 32768.0f;
+    case 24: {
+        qint32 v = p[0] | (p[1] << 8) | (p[2] << 16);
+        if (v & 0x800000) v |= ~0xFFFFFF;
+        return v / 8388608.0f;
+    }
+    default:
+        if (wav.format == WAVE_FORMAT_IEEE_FLOAT) {
+            quint32 bits = qFromLittleEndian<quint32>(p);
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return f;
+        }
+        return qFromLittleEndian<qint32>(p) / 2147483648.0f;
+    }
+}
+
+inline qint16 floatToSample(float v) {
+    return (qint16)qBound(-32768L, std::lrint(v * 32767.0f), 32767L);
+}
+
+// 按块读取 WAV 并转换成输出格式：立体声、16 位、outRate 采样率（线性插值重采样）
+// 内存占用只有一个数据块，与文件长度无关；loop 为 true 时读到结尾无缝回到开头
+class WavStream {
+public:
+    bool open(const QString& path, int outRate, bool loop) {
+        m_file.setFileName(path);
+        if (!m_file.open(QIODevice::ReadOnly)) return false;
+        if (!readWavHeader(m_file, m_wav) || m_wav.dataSize < m_wav.blockAlign) return false;
+
+        m_loop = loop;
+        m_step = (double)m_wav.sampleRate / outRate;
+        m_pos = 0.0;
+        m_in.clear();
+        m_inFrames = 0;
+        return rewind();
+    }
+
+    // 输出帧数估计（整段解码时用于预分配）
+    qint64 outputFrames() const { return (qint64)(m_wav.dataSize / m_wav.blockAlign / m_step); }
+
+    // 写出最多 frames 帧，返回实际帧数；不循环时读到结尾会少于 frames
+    int read(qint16* out, int frames) {
+        int produced = 0;
+        while (produced < frames) {
+            // 插值需要当前帧和下一帧
+            if (m_pos + 1 >= m_inFrames && !refill()) break;
+
+            int idx = (int)m_pos;
+            float frac = (float)(m_pos - idx);
+            const float* a = m_in.constData() + idx * 2;
+            *out++ = floatToSample(a[0] + (a[2] - a[0]) * frac);
+            *out++ = floatToSample(a[1] + (a[3] - a[1]) * frac);
+            m_pos += m_step;
+            ++produced;
+        }
+        return produced;
+    }
+
+private:
+    static const int ChunkFrames = 4096;
+
+    bool rewind() {
+        m_remaining = m_wav.dataSize;
+        return m_file.seek(m_wav.dataOffset);
+    }
+
+    // 丢掉已经用完的帧（保留最后一帧给插值），再解码下一块
+    bool refill() {
+        if (m_inFrames > 0) {
+            int keep = qMin((int)m_pos, m_inFrames - 1);
+            m_in.remove(0, keep * 2);
+            m_inFrames -= keep;
+            m_pos -= keep;
+        }
+
+        qint64 want = qMin<qint64>((qint64)ChunkFrames * m_wav.blockAlign, m_remaining);
+        if (want < m_wav.blockAlign) {
+            if (!m_loop || !rewind()) return false;
+            want = qMin<qint64>((qint64)ChunkFrames * m_wav.blockAlign, m_remaining);
+        }
+
+        m_raw.resize((int)want);
+        qint64 got = m_file.read(m_raw.data(), want);
+        int frames = got > 0 ? (int)(got / m_wav.blockAlign) : 0;
+        if (frames == 0) return false;
+        m_remaining -= got;
+
+        const uchar* src = reinterpret_cast<const uchar*>(m_raw.constData());
+        const int rightOffset = m_wav.channels > 1 ? m_wav.bitsPerSample / 8 : 0; // 单声道左右相同
+        m_in.resize((m_inFrames + frames) * 2);
+        float* dst = m_in.data() + m_inFrames * 2;
+        for (int i = 0; i < frames; ++i, src += m_wav.blockAlign) {
+            *dst++ = sampleToFloat(src, m_wav);
+            *dst++ = sampleToFloat(src + rightOffset, m_wav);
+        }
+        m_inFrames += frames;
+        return m_pos + 1 < m_inFrames || refill();
+    }
+
+    QFile m_file;
+    WavFormat m_wav;
+    bool m_loop = false;
+    double m_step = 1.0;
+    double m_pos = 0.0;      // 在 m_in 中的小数位置
+    qint64 m_remaining = 0;  // data 块剩余字节
+    QByteArray m_raw;
+    QVector<float> m_in;     // 已解码的交错立体声帧
+    int m_inFrames = 0;
+};
+
+// 整个 WAV 解码成输出格式（短音效）
+bool decodeWav(const QString& path, int outRate, AudioMixer::Pcm& out) {
+    WavStream stream;
+    if (!stream.open(path, outRate, false)) return false;
+
+    const int block = 1024;
+    out.clear();
+    out.reserve((int)stream.outputFrames() * 2 + block * 2);
+    int frames;
+    do {
+        int size = out.size();
+        out.resize(size + block * 2);
+        frames = stream.read(out.data() + size, block);
+        out.resize(size + frames * 2);
+    } while (frames == block);
+    return !out.isEmpty();
+}
+
+} // namespace
+
+// 拉模式数据源：QAudioOutput 需要数据时在音频线程里调用 readData 现场混音
+class MixerDevice : public QIODevice {
+public:
+    explicit MixerDevice(int sampleRate) : m_sampleRate(sampleRate) {}
+
+    // 主线程调用：只把请求放进队列，真正分配通道在音频线程
+    void trigger(const QSharedPointer<const AudioMixer::Pcm>& pcm) {
+        QMutexLocker locker(&m_pendingLock);
+        m_pending.append(pcm);
+    }
+
+    // 以下两个只在音频线程调用
+    void startMusic(const QString& path) {
+        m_music.reset(new WavStream);
+        if (!m_music->open(path, m_sampleRate, true)) {
+            qWarning() << "AudioMixer: failed to stream" << path;
+            m_music.reset();
+        }
+    }
+    void stopMusic() { m_music.reset(); }
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return 4096 + QIODevice::bytesAvailable(); } // 混音流没有尽头
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override {
+        const int frames = (int)(maxlen / (2 * sizeof(qint16)));
+        if (frames <= 0) return 0;
+
+        takePending();
+
+        m_mixBuffer.fill(0, frames * 2);
+        qint32* mix = m_mixBuffer.data();
+        for (Voice& voice : m_voices) {
+            if (!voice.pcm) continue;
+            const qint16* src = voice.pcm->constData() + voice.pos;
+            int count = qMin(frames * 2, voice.pcm->size() - voice.pos);
+            for (int i = 0; i < count; ++i) mix[i] += src[i];
+            voice.pos += count;
+            if (voice.pos >= voice.pcm->size()) voice.pcm.reset(); // 播完释放通道
+        }
+
+        if (m_music) {
+            m_musicBuffer.resize(frames * 2);
+            int count = m_music->read(m_musicBuffer.data(), frames) * 2;
+            const qint16* src = m_musicBuffer.constData();
+            for (int i = 0; i < count; ++i) mix[i] += src[i];
+        }
+
+        qint16* out = reinterpret_cast<qint16*>(data);
+        for (int i = 0; i < frames * 2; ++i) {
+            out[i] = (qint16)qBound(-32768, mix[i], 32767);
+        }
+        return frames * 2 * sizeof(qint16);
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    struct Voice {
+        QSharedPointer<const AudioMixer::Pcm> pcm; // 为空表示通道空闲
+        int pos = 0;
+    };
+
+    void takePending() {
+        QVector<QSharedPointer<const AudioMixer::Pcm>> pending;
+        {
+            QMutexLocker locker(&m_pendingLock);
+            if (m_pending.isEmpty()) return;
+            pending.swap(m_pending);
+        }
+        for (const auto& pcm : pending) {
+            // 优先用空闲通道，没有就顶掉已经播放最久的
+            Voice* target = &m_voices[0];
+            for (Voice& voice : m_voices) {
+                if (!voice.pcm) { target = &voice; break; }
+                if (voice.pos > target->pos) target = &voice;
+            }
+            target->pcm = pcm;
+            target->pos = 0;
+        }
+    }
+
+    int m_sampleRate;
+    Voice m_voices[AudioMixer::VoiceCount];
+    QVector<qint32> m_mixBuffer;
+
+    QScopedPointer<WavStream> m_music; // 当前背景音乐，边播边解码
+    QVector<qint16> m_musicBuffer;
+
+    QMutex m_pendingLock;
+    QVector<QSharedPointer<const AudioMixer::Pcm>> m_pending;
+};
+
+AudioMixer& AudioMixer::instance() {
+    static AudioMixer instance;
+    return instance;
+}
+
+AudioMixer::AudioMixer() : m_enabled(false), m_device(nullptr) {
+    m_format.setSampleRate(44100);
+    m_format.setChannelCount(2);
+    m_format.setSampleSize(16);
+    m_format.setCodec("audio/pcm");
+    m_format.setByteOrder(QAudioFormat::LittleEndian);
+    m_format.setSampleType(QAudioFormat::SignedInt);
+
+    QAudioDeviceInfo info = QAudioDeviceInfo::defaultOutputDevice();
+    if (info.isNull()) {
+        qWarning() << "AudioMixer: no audio output device";
+        return;
+    }
+    if (!info.isFormatSupported(m_format)) {
+        // 只接受换采样率，其余格式混音器不支持
+        QAudioFormat nearest = info.nearestFormat(m_format);
+        if (nearest.sampleSize() != 16 || nearest.channelCount() != 2
+            || nearest.sampleType() != QAudioFormat::SignedInt
+            || nearest.byteOrder() != QAudioFormat::LittleEndian) {
+            qWarning() << "AudioMixer: unsupported output format" << nearest;
+            return;
+        }
+        m_format = nearest;
+    }
+
+    m_enabled = true;
+    start();
+}
+
+AudioMixer::~AudioMixer() {
+    shutdown();
+}
+
+void AudioMixer::start() {
+    m_thread.setObjectName("AudioMixer");
+    m_thread.start(QThread::TimeCriticalPriority);
+
+    m_device = new MixerDevice(m_format.sampleRate());
+    m_device->moveToThread(&m_thread);
+
+    const QAudioFormat format = m_format;
+    MixerDevice* device = m_device;
+    QMetaObject::invokeMethod(m_device, [device, format]() {
+        device->open(QIODevice::ReadOnly);
+        // QAudioOutput 挂在 device 下，随它一起在音频线程中销毁
+        QAudioOutput* output = new QAudioOutput(format, device);
+        output->setBufferSize(format.bytesForDuration(40000)); // 约 40ms 缓冲
+        output->start(device);
+    }, Qt::QueuedConnection);
+
+    if (QCoreApplication::instance()) {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [this]() { shutdown(); });
+    }
+}
+
+void AudioMixer::shutdown() {
+    if (!m_device) return;
+
+    MixerDevice* device = m_device;
+    m_device = nullptr;
+    m_enabled = false;
+    QMetaObject::invokeMethod(device, [device]() {
+        for (QAudioOutput* output : device->findChildren<QAudioOutput*>()) output->stop();
+        delete device;
+    }, Qt::BlockingQueuedConnection);
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+int AudioMixer::load(const QString& path) {
+    auto it = m_ids.constFind(path);
+    if (it != m_ids.constEnd()) return it.value();
+
+    QSharedPointer<Pcm> pcm(new Pcm);
+    if (!decodeWav(path, m_format.sampleRate(), *pcm)) {
+        qWarning() << "AudioMixer: failed to decode" << path;
+        m_ids.insert(path, -1);
+        return -1;
+    }
+
+    int id = m_sounds.size();
+    m_sounds.append(pcm);
+    m_ids.insert(path, id);
+    return id;
+}
+
+void AudioMixer::play(int soundId) {
+    if (!m_enabled || soundId < 0 || soundId >= m_sounds.size()) return;
+    m_device->trigger(m_sounds[soundId]);
+}
+
+void AudioMixer::playMusic(const QString& path) {
+    if (!m_enabled) return;
+    MixerDevice* device = m_device;
+    QMetaObject::invokeMethod(m_device, [device, path]() { device->startMusic(path); }, Qt::QueuedConnection);
+}
+
+void AudioMixer::stopMusic() {
+    if (!m_enabled) return;
+    MixerDevice* device = m_device;
+    QMetaObject::invokeMethod(m_device, [device]() { device->stopMusic(); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,57 @@
+﻿#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include "gamecore_global.h"
+#include <QString>
+#include <QHash>
+#include <QVector>
+#include <QSharedPointer>
+#include <QThread>
+#include <QtMultimedia/QAudioFormat>
+
+class MixerDevice;
+
+// 软件混音器
+// 所有音效在 load 时解码成统一格式（16 位立体声，输出设备采样率）的 PCM，
+// 同一个文件只解码一次；play 只是把声音交给固定数量的发声通道，
+// 由独立的音频线程以拉模式 (pull mode) 混音后送给 QAudioOutput。
+// 连续按键时同一音效可以叠加播放，不会像 QSoundEffect 那样被重新开始打断。
+// 背景音乐不整段载入，而是在音频线程里边读边混。
+class GAMECORE_EXPORT AudioMixer {
+public:
+    static AudioMixer& instance();
+
+    // 解码并缓存音效，返回 id；同一路径重复调用返回同一个 id，失败返回 -1
+    int load(const QString& path);
+
+    // 播放音效，可与正在播放的音效叠加；通道占满时顶掉播放最久的一个
+    void play(int soundId);
+
+    // 背景音乐：从资源按块流式解码，无缝循环，内存占用与曲长无关。
+    // 同一时间只有一首，再次调用从头播放新曲目
+    void playMusic(const QString& path);
+    void stopMusic();
+
+    void shutdown(); // 停止音频线程（程序退出前调用）
+
+    typedef QVector<qint16> Pcm; // 交错的立体声采样
+    static const int VoiceCount = 16;
+
+private:
+    AudioMixer();
+    ~AudioMixer();
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    void start();
+
+    QAudioFormat m_format;
+    bool m_enabled;
+    QThread m_thread;        // 音频线程，QAudioOutput 和 MixerDevice 都在这里
+    MixerDevice* m_device;
+
+    QHash<QString, int> m_ids;
+    QVector<QSharedPointer<const Pcm>> m_sounds;
+};
+
+#endif // AUDIOMIXER_H
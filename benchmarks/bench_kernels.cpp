@@ -0,0 +1,495 @@
+﻿#include "benchaccess.h"
+#include "datamanager.h"
+#include "textimport.h"
+#include "passageindex.h"
+#include "typingribbon.h"
+#include "scorestore.h"
+#include "gamestats.h"
+#include "typinganalytics.h"
+#include "contentgenerator.h"
+#include <benchmark/benchmark.h>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QTemporaryDir>
+#include <QTextCodec>
+
+const quint32 BENCH_SEED = 20240601;
+
+// ---------------- SpaceGame ----------------
+
+static void BM_SpaceCheckCollisions(benchmark::State& state) {
+    SpaceGame game;
+    BenchAccess::fillSpace(game, state.range(0), BENCH_SEED);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BenchAccess::spaceCollisions(game));
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SpaceCheckCollisions)->RangeMultiplier(4)->Range(16, 1024)->Complexity();
+
+// 完整一帧：追踪子弹寻找目标 + 移动 + 碰撞 + 清理
+static void BM_SpaceTickHoming(benchmark::State& state) {
+    SpaceGame game;
+    for (auto _ : state) {
+        state.PauseTiming();
+        BenchAccess::fillSpace(game, state.range(0), BENCH_SEED);
+        state.ResumeTiming();
+        BenchAccess::spaceTick(game);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SpaceTickHoming)->RangeMultiplier(4)->Range(16, 1024)->Complexity();
+
+// 一帧内一半实体同时死亡：移除代价应与死亡数量成正比，而不是 O(n^2)
+static void BM_SpaceTickKillHalf(benchmark::State& state) {
+    SpaceGame game;
+    for (auto _ : state) {
+        state.PauseTiming();
+        BenchAccess::fillSpaceHalfDead(game, state.range(0), BENCH_SEED);
+        state.ResumeTiming();
+        BenchAccess::spaceTick(game);
+    }
+    state.counters["survivors"] = BenchAccess::spaceEntityCount(game);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SpaceTickKillHalf)->RangeMultiplier(10)->Range(100, 10000)->Complexity();
+
+// ---------------- FrogGame ----------------
+
+// 不匹配任何单词的按键：最坏情况下要扫描全部荷叶
+static void BM_FrogCheckInputMiss(benchmark::State& state) {
+    FrogGame game;
+    BenchAccess::fillFrogLeaves(game, state.range(0), BENCH_SEED);
+    QString key("#");
+    for (auto _ : state) {
+        BenchAccess::frogCheckInput(game, key);
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FrogCheckInputMiss)->RangeMultiplier(4)->Range(16, 16384)->Complexity();
+
+// 词库加载：生成 N 个单词的临时词典文件
+static void BM_FrogLoadDictionary(benchmark::State& state) {
+    const int wordCount = state.range(0);
+    QString dirPath = QCoreApplication::applicationDirPath() + "/Data/English/T_WORD/Dictionary";
+    QDir().mkpath(dirPath);
+    QString fileName = QString("bench_%1.ID").arg(wordCount);
+
+    QFile file(dirPath + "/" + fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        state.SkipWithError("cannot write dictionary");
+        return;
+    }
+    QRandomGenerator rng(BENCH_SEED);
+    QByteArray word;
+    for (int i = 0; i < wordCount; ++i) {
+        word.clear();
+        int len = 2 + rng.bounded(8);
+        for (int c = 0; c < len; ++c) word.append(char('a' + rng.bounded(26)));
+        file.write(word);
+        file.write("\r\n");
+    }
+    file.close();
+
+    FrogGame game;
+    for (auto _ : state) {
+        BenchAccess::frogLoadDictionary(game, fileName);
+    }
+    state.SetBytesProcessed(state.iterations() * file.size());
+    state.counters["words"] = BenchAccess::frogWordCount(game);
+
+    QFile::remove(dirPath + "/" + fileName);
+}
+BENCHMARK(BM_FrogLoadDictionary)->RangeMultiplier(8)->Range(1 << 10, 1 << 18)->Unit(benchmark::kMillisecond);
+
+// ---------------- PoliceGame ----------------
+
+static void BM_PoliceGetCarState(benchmark::State& state) {
+    PoliceGame game;
+    double total = BenchAccess::policeMapLength(game);
+    double dist = 0.0;
+    QPointF pos;
+    QPixmap sprite;
+    for (auto _ : state) {
+        BenchAccess::policeCarState(game, dist, pos, sprite);
+        benchmark::DoNotOptimize(pos);
+        dist += 7.3;
+        if (dist > total) dist -= total;
+    }
+}
+BENCHMARK(BM_PoliceGetCarState);
+
+// ---------------- DataManager ----------------
+
+// 文件不变时第一轮之后都命中 TextImporter 的缓存，只剩目录扫描和 stat
+static void BM_LoadArticlesFromDir(benchmark::State& state) {
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        state.SkipWithError("cannot create temp dir");
+        return;
+    }
+
+    const int fileCount = state.range(0);
+    QRandomGenerator rng(BENCH_SEED);
+    qint64 totalBytes = 0;
+    for (int i = 0; i < fileCount; ++i) {
+        QFile file(dir.path() + QString("/article_%1.txt").arg(i));
+        if (!file.open(QIODevice::WriteOnly)) continue;
+        QByteArray text;
+        for (int w = 0; w < 400; ++w) {
+            int len = 1 + rng.bounded(9);
+            for (int c = 0; c < len; ++c) text.append(char('a' + rng.bounded(26)));
+            text.append((w % 15 == 14) ? "\r\n" : " ");
+        }
+        totalBytes += file.write(text);
+    }
+
+    for (auto _ : state) {
+        DataManager::instance().loadArticlesFromDir(dir.path());
+    }
+    state.SetBytesProcessed(state.iterations() * totalBytes);
+}
+BENCHMARK(BM_LoadArticlesFromDir)->RangeMultiplier(4)->Range(16, 1024)->Unit(benchmark::kMillisecond);
+
+// 不经缓存的识别 + 解码 + 整理：Arg(0) 纯 ASCII，Arg(1) 中英混排 UTF-8，Arg(2) GBK
+static void BM_TextImportDecode(benchmark::State& state) {
+    const QString sample = state.range(0) == 0
+        ? QString("The quick brown fox jumps over the lazy dog.\r\n")
+        : QStringLiteral("打字练习 The quick brown fox\t跳过了懒狗。\r\n");
+    QString text;
+    while (text.size() < 64 * 1024) text += sample;
+
+    QByteArray data;
+    if (state.range(0) == 2) {
+        QTextCodec* gbk = QTextCodec::codecForName("GBK");
+        if (!gbk) {
+            state.SkipWithError("GBK codec not available");
+            return;
+        }
+        data = gbk->fromUnicode(text);
+    }
+    else {
+        data = text.toUtf8();
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(TextImporter::normalize(TextImporter::decode(data)));
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_TextImportDecode)->DenseRange(0, 2);
+
+// 长文章切段 + 计算难度：应与文章长度成线性
+static void BM_PassageIndexBuild(benchmark::State& state) {
+    QRandomGenerator rng(BENCH_SEED);
+    QString text;
+    while (text.size() < state.range(0)) {
+        int words = 5 + rng.bounded(20);
+        for (int w = 0; w < words; ++w) {
+            int len = 1 + rng.bounded(9);
+            for (int c = 0; c < len; ++c) text.append(QChar('a' + rng.bounded(26)));
+            text.append(w + 1 < words ? ' ' : '.');
+        }
+        text.append(' ');
+    }
+
+    for (auto _ : state) {
+        PassageIndex index;
+        index.addArticle(text);
+        benchmark::DoNotOptimize(index.passageCount());
+    }
+    state.SetComplexityN(state.range(0));
+    state.SetBytesProcessed(state.iterations() * text.size() * sizeof(QChar));
+}
+BENCHMARK(BM_PassageIndexBuild)->RangeMultiplier(8)->Range(1 << 12, 1 << 21)->Complexity();
+
+// ---------------- ScoreStore ----------------
+
+// 提交 N 条成绩后查询榜单和个人最佳：耗时不应随历史条数增长
+static void BM_ScoreStoreQuery(benchmark::State& state) {
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        state.SkipWithError("cannot create temp dir");
+        return;
+    }
+    ScoreStore& store = ScoreStore::instance();
+    store.setFileName(dir.path() + "/scores.dat");
+
+    QRandomGenerator rng(BENCH_SEED);
+    for (int i = 0; i < state.range(0); ++i) {
+        store.addScore("bench", 0, QString("player%1").arg(rng.bounded(64)), rng.bounded(100000));
+    }
+
+    int best = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(store.topScores("bench", 0, 9));
+        best += store.personalBest("bench", 0, "player7");
+    }
+    benchmark::DoNotOptimize(best);
+    state.counters["fileBytes"] = QFileInfo(dir.path() + "/scores.dat").size();
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ScoreStoreQuery)->RangeMultiplier(8)->Range(64, 1 << 15)->Complexity();
+
+// 历史记录 N 局后重新加载统计：日志会被压缩，加载时间不随局数线性增长
+static void BM_GameStatsLoad(benchmark::State& state) {
+    QTemporaryDir dir;
+    if (!dir.isValid()) {
+        state.SkipWithError("cannot create temp dir");
+        return;
+    }
+    GameStats& stats = GameStats::instance();
+    ScoreStore::instance().setFileName(dir.path() + "/scores.dat");
+    const QString path = dir.path() + "/stats.dat";
+    stats.setFileName(path);
+
+    QRandomGenerator rng(BENCH_SEED);
+    const char* games[] = { "mole", "apple", "frog", "police", "space" };
+    for (int i = 0; i < state.range(0); ++i) {
+        GameRecord r;
+        r.game = games[i % 5];
+        r.player = QString("player%1").arg(rng.bounded(8));
+        r.score = rng.bounded(10000);
+        r.accuracy = rng.bounded(1.0);
+        r.wpm = rng.bounded(80.0);
+        r.durationMs = 60000;
+        r.timestamp = i;
+        stats.record(r);
+    }
+    stats.waitForIdle();
+
+    for (auto _ : state) {
+        stats.setFileName(path);
+    }
+    state.counters["fileBytes"] = QFileInfo(path).size();
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GameStatsLoad)->RangeMultiplier(8)->Range(64, 1 << 15)->Complexity()->Unit(benchmark::kMillisecond);
+
+// ---------------- TypingAnalytics ----------------
+
+// 输入路径上的开销：只写环形缓冲区，分析线程并行消费
+static void BM_TypingAnalyticsRecord(benchmark::State& state) {
+    TypingAnalytics& analytics = TypingAnalytics::instance();
+    analytics.flush();
+    const quint64 droppedBefore = analytics.metrics().dropped;
+    int i = 0;
+    for (auto _ : state) {
+        QChar expected('A' + i % 26);
+        QChar actual = (i % 17 == 0) ? QChar('A' + (i + 1) % 26) : expected;
+        analytics.record(expected, actual);
+        ++i;
+    }
+    analytics.flush();
+    TypingMetrics m = analytics.metrics();
+    state.counters["dropped"] = double(m.dropped - droppedBefore);
+    state.counters["accuracy"] = m.accuracy;
+}
+BENCHMARK(BM_TypingAnalyticsRecord);
+
+// ---------------- ContentGenerator ----------------
+
+// 有薄弱键数据时的加权抽样：每次应与均匀随机同一量级
+static void BM_ContentGeneratorLetter(benchmark::State& state) {
+    TypingMetrics metrics;
+    for (int i = 0; i < 26; ++i) {
+        metrics.keyAttempts['A' + i] = 50;
+        metrics.keyErrorRate['A' + i] = (i % 5 == 0) ? 0.4 : 0.02;
+        for (int j = 0; j < 26; ++j) metrics.bigramAttempts[TypingMetrics::bigramOf(i, j)] = 10;
+    }
+    metrics.bigramErrorRate[TypingMetrics::bigramOf('T' - 'A', 'H' - 'A')] = 0.5;
+    ContentGenerator& generator = ContentGenerator::instance();
+    generator.refresh(metrics);
+
+    GameRandom rng(BENCH_SEED);
+    char previous = 0;
+    for (auto _ : state) {
+        previous = generator.letter(rng, previous);
+        benchmark::DoNotOptimize(previous);
+    }
+}
+BENCHMARK(BM_ContentGeneratorLetter);
+
+// 换玩家：上一个玩家按错的键不能影响没按错过的玩家，换回来时他的权重还在
+static void BM_ContentGeneratorSwitchPlayer(benchmark::State& state) {
+    GameStats& stats = GameStats::instance();
+    TypingAnalytics& analytics = TypingAnalytics::instance();
+    ContentGenerator& generator = ContentGenerator::instance();
+    const QString original = stats.playerName();
+    GameRandom rng(BENCH_SEED);
+
+    stats.setPlayerName(QStringLiteral("bench-a"));
+    generator.letter(rng);
+    for (int i = 0; i < 50; ++i) analytics.record(QChar('Q'), QChar('W'));
+    analytics.flush();
+    generator.refresh(analytics.metrics());
+    const double weakWeight = generator.letterWeight('Q' - 'A');
+    if (weakWeight <= 1.0) { state.SkipWithError("errors did not raise the weight"); return; }
+
+    int i = 0;
+    for (auto _ : state) {
+        stats.setPlayerName(i++ % 2 ? QStringLiteral("bench-b") : QStringLiteral("bench-c"));
+        generator.letter(rng);
+        analytics.flush();
+        generator.refresh(analytics.metrics());
+        for (int letter = 0; letter < ContentGenerator::LetterCount; ++letter) {
+            if (generator.letterWeight(letter) != 1.0) { state.SkipWithError("weights leaked to a new player"); return; }
+        }
+    }
+
+    stats.setPlayerName(QStringLiteral("bench-a"));
+    generator.letter(rng);
+    if (generator.letterWeight('Q' - 'A') != weakWeight) state.SkipWithError("weights lost after switching back");
+    stats.setPlayerName(original);
+    generator.letter(rng);
+}
+BENCHMARK(BM_ContentGeneratorSwitchPlayer);
+
+// ---------------- 快照 ----------------
+
+// 挂起：N 个苹果的一局写成快照
+static void BM_SnapshotSave(benchmark::State& state) {
+    AppleGame game;
+    BenchAccess::fillApples(game, state.range(0), BENCH_SEED, true);
+    QByteArray snapshot;
+    for (auto _ : state) {
+        snapshot = game.saveSnapshot();
+        benchmark::DoNotOptimize(snapshot.constData());
+    }
+    state.counters["bytes"] = snapshot.size();
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SnapshotSave)->RangeMultiplier(8)->Range(64, 1 << 15)->Complexity();
+
+// 恢复：包括重建实体池和字母索引，基准可以直接从这样的中盘状态开始
+static void BM_SnapshotRestore(benchmark::State& state) {
+    AppleGame game;
+    BenchAccess::fillApples(game, state.range(0), BENCH_SEED, true);
+    // 快照取在大量随机数之后，恢复耗时不应随已取个数增长
+    BenchAccess::advanceRandom(game, Q_UINT64_C(1) << 24);
+    const QByteArray snapshot = game.saveSnapshot();
+    for (auto _ : state) {
+        if (!game.restoreSnapshot(snapshot)) {
+            state.SkipWithError("restore failed");
+            return;
+        }
+    }
+    state.counters["apples"] = BenchAccess::appleCount(game);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SnapshotRestore)->RangeMultiplier(8)->Range(64, 1 << 15)->Complexity();
+
+// ---------------- 每帧绘制 ----------------
+
+template <typename Game>
+static void runDrawLoop(benchmark::State& state, Game& game) {
+    QImage frame(800, 600, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&frame);
+    for (auto _ : state) {
+        painter.save();
+        game.draw(painter);
+        painter.restore();
+    }
+    painter.end();
+    state.counters["fps"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+static void BM_DrawSpace(benchmark::State& state) {
+    SpaceGame game;
+    BenchAccess::fillSpace(game, state.range(0), BENCH_SEED);
+    runDrawLoop(state, game);
+}
+BENCHMARK(BM_DrawSpace)->Arg(16)->Arg(128)->Arg(512);
+
+static void BM_DrawApple(benchmark::State& state) {
+    AppleGame game;
+    BenchAccess::fillApples(game, state.range(0), BENCH_SEED);
+    runDrawLoop(state, game);
+}
+BENCHMARK(BM_DrawApple)->Arg(16)->Arg(128)->Arg(512);
+
+// 无尽模式压力测试：成千上万个苹果时完整的一帧（生成 + 下落 + 绘制）
+static void BM_AppleEndlessFrame(benchmark::State& state) {
+    AppleGame game;
+    QImage frame(800, 600, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&frame);
+    int frames = 0;
+    for (auto _ : state) {
+        // 苹果会落地移除，定期补满让数量保持在量级内
+        if (frames++ % 256 == 0) {
+            state.PauseTiming();
+            BenchAccess::fillApples(game, state.range(0), BENCH_SEED, true);
+            state.ResumeTiming();
+        }
+        BenchAccess::appleTick(game);
+        painter.save();
+        game.draw(painter);
+        painter.restore();
+    }
+    painter.end();
+    state.counters["apples"] = BenchAccess::appleCount(game);
+    state.counters["fps"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_AppleEndlessFrame)->Arg(1000)->Arg(4000)->Unit(benchmark::kMillisecond);
+
+static void BM_DrawFrog(benchmark::State& state) {
+    FrogGame game;
+    BenchAccess::fillFrogLeaves(game, state.range(0), BENCH_SEED);
+    runDrawLoop(state, game);
+}
+BENCHMARK(BM_DrawFrog)->Arg(9)->Arg(64);
+
+static void BM_DrawPolice(benchmark::State& state) {
+    PoliceGame game;
+    game.initGame();
+    runDrawLoop(state, game);
+}
+BENCHMARK(BM_DrawPolice);
+
+// 每帧都前进一个字：输入条排版的最坏情况（正常打字时远低于帧率）
+static void BM_DrawPoliceTyping(benchmark::State& state) {
+    PoliceGame game;
+    BenchAccess::fillPolice(game, BENCH_SEED);
+    QImage frame(800, 600, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&frame);
+    for (auto _ : state) {
+        BenchAccess::policeAdvance(game);
+        painter.save();
+        game.draw(painter);
+        painter.restore();
+    }
+    painter.end();
+}
+BENCHMARK(BM_DrawPoliceTyping);
+
+// 打字条每帧前进一个字：耗时应与文本总长无关（1K 字符到整本书）
+static void BM_TypingRibbonDraw(benchmark::State& state) {
+    QRandomGenerator rng(BENCH_SEED);
+    QString text(state.range(0), Qt::Uninitialized);
+    for (int i = 0; i < text.size(); ++i) text[i] = (i % 7 == 6) ? QChar(' ') : QChar('a' + rng.bounded(26));
+
+    TypingRibbon ribbon(QFont("Arial", 16, QFont::Bold));
+    ribbon.setText(text);
+    QImage frame(800, 600, QImage::Format_ARGB32_Premultiplied);
+    QPainter painter(&frame);
+    const QRectF viewport(130, 500, 540, 36);
+    int caret = text.size() / 2;
+    for (auto _ : state) {
+        ribbon.setCaret(++caret % text.size());
+        ribbon.draw(painter, viewport, 526, Qt::black, Qt::gray, Qt::blue);
+    }
+    painter.end();
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_TypingRibbonDraw)->RangeMultiplier(16)->Range(1 << 10, 1 << 22)->Complexity();
+
+static void BM_DrawMole(benchmark::State& state) {
+    MoleGame game;
+    game.initGame();
+    runDrawLoop(state, game);
+}
+BENCHMARK(BM_DrawMole);
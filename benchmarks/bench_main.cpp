@@ -0,0 +1,18 @@
+﻿#include <QApplication>
+#include <benchmark/benchmark.h>
+
+// 基准测试入口：先建 QApplication（QPixmap / QSoundEffect 都依赖它），再交给 Google Benchmark
+int main(int argc, char* argv[]) {
+    // 没有显示器的机器上也能跑
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+﻿#ifndef BENCHACCESS_H
+#define BENCHACCESS_H
+
+// 基准测试专用：作为各游戏类的友元，直接构造/驱动内部状态，
+// 这样不需要改动游戏的公开接口就能单独测量热点函数。
+
+#include "spacegame.h"
+#include "froggame.h"
+#include "policegame.h"
+#include "applegame.h"
+#include "molegame.h"
+#include <QRandomGenerator>
+
+class BenchAccess {
+public:
+    // SpaceGame：count 个敌人 + count 颗带追踪目标的子弹
+    // 子弹放在屏幕下方、敌人放在上方，保证本帧内不会互相碰撞，测到的是完整扫描开销
+    static void fillSpace(SpaceGame& game, int count, quint32 seed) {
+        QRandomGenerator rng(seed);
+        game.seedRandom(seed);
+        game.initGame();
+        game.hideMenuUI();
+        game.m_state = GameState::Playing;
+        game.m_lives = 1 << 20;
+        game.m_spawnInterval = 1 << 20;
+
+        game.m_entities.clear();
+        game.m_entities.reserve(count * 2);
+
+        for (int i = 0; i < count; ++i) {
+            QPointF pos(rng.bounded(50, 750), rng.bounded(-50, 250));
+            QString letter(QChar('A' + rng.bounded(26)));
+            game.m_entities.add(SpaceEntity(Type_Enemy, pos, QPointF(0, 1 + rng.bounded(2)), letter));
+        }
+        for (int i = 0; i < count; ++i) {
+            SpaceEntity bullet(Type_Bullet, QPointF(rng.bounded(50, 750), rng.bounded(420, 500)), QPointF(0, -15.0));
+            bullet.targetLetter = game.m_entities[rng.bounded(count)].letter;
+            game.m_entities.add(bullet);
+        }
+    }
+
+    // SpaceGame：count 个敌人，随机一半已经越过屏幕底部，下一帧全部移除
+    // 没有子弹，测的是大批实体同时死亡时的移除开销
+    static void fillSpaceHalfDead(SpaceGame& game, int count, quint32 seed) {
+        QRandomGenerator rng(seed);
+        game.seedRandom(seed);
+        game.initGame();
+        game.hideMenuUI();
+        game.m_state = GameState::Playing;
+        game.m_lives = 1 << 20;
+        game.m_spawnInterval = 1 << 20;
+
+        game.m_entities.clear();
+        game.m_entities.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            double y = (rng.bounded(2) == 0) ? SCREEN_HEIGHT + 60 : rng.bounded(-50, 250);
+            QPointF pos(rng.bounded(50, 750), y);
+            game.m_entities.add(SpaceEntity(Type_Enemy, pos, QPointF(0, 1), QString(QChar('A' + rng.bounded(26)))));
+        }
+    }
+
+    static void spaceTick(SpaceGame& game) { game.onGameTick(); }
+    static bool spaceCollisions(SpaceGame& game) { return game.checkCollisions(); }
+    static int spaceEntityCount(const SpaceGame& game) { return game.m_entities.size(); }
+
+    // FrogGame：count 片荷叶全部放在下一排，单词取自当前词库
+    static void fillFrogLeaves(FrogGame& game, int count, quint32 seed) {
+        QRandomGenerator rng(seed);
+        game.seedRandom(seed);
+        game.initGame();
+        game.m_state = GameState::Playing;
+
+        game.m_leaves.clear();
+        game.m_leaves.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            const QString& w = game.m_wordList[rng.bounded(game.m_wordList.size())];
+            game.addLeaf(i % 3, rng.bounded(60, 740), 0.5, w);
+        }
+    }
+
+    // 每次判定后清掉锁定状态，保证迭代之间互不影响
+    static void frogCheckInput(FrogGame& game, const QString& key) {
+        game.checkInput(key);
+        game.m_inputBuffer.clear();
+        game.m_lockedLeaf = LeafHandle();
+        game.m_isGoalLocked = false;
+    }
+
+    static void frogLoadDictionary(FrogGame& game, const QString& filename) { game.loadDictionary(filename); }
+    static int frogWordCount(const FrogGame& game) { return game.m_wordList.size(); }
+
+    static void policeCarState(PoliceGame& game, double distance, QPointF& outPos, QPixmap& outSprite) {
+        game.getCarState(distance, 1, game.m_policeSprites, outPos, outSprite);
+    }
+    static double policeMapLength(const PoliceGame& game) { return game.m_totalMapLength; }
+
+    // AppleGame：count 个苹果散布在空中
+    static void fillApples(AppleGame& game, int count, quint32 seed, bool endless = false) {
+        QRandomGenerator rng(seed);
+        AppleSettingsData settings;
+        settings.endless = endless;
+        game.updateSettings(settings);
+        game.seedRandom(seed);
+        game.initGame();
+        game.m_state = GameState::Playing;
+
+        game.m_apples.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            char letter = char('A' + rng.bounded(26));
+            QPointF pos(rng.bounded(60, 740), rng.bounded(0, 500));
+            game.m_letterIndex.insert(letter, game.m_apples.add(Apple(pos, 1.0, letter)));
+        }
+    }
+
+    // 让游戏的随机数源往前走 draws 个数，模拟玩了很久之后的状态
+    static void advanceRandom(AppleGame& game, quint64 draws) {
+        for (quint64 i = 0; i < draws; ++i) game.m_rng.generate();
+    }
+
+    static void appleTick(AppleGame& game) { game.onGameTick(); }
+    static int appleCount(const AppleGame& game) { return game.m_apples.size(); }
+
+    // MoleGame：洞数按 count 取 8 的倍数（最多 64），count 个地鼠同时露头
+    static void fillMoles(MoleGame& game, int count, quint32 seed) {
+        QRandomGenerator rng(seed);
+        GameSettingsData settings;
+        settings.holeCount = qBound(8, (count + 7) / 8 * 8, (int)MoleGame::MaxHoles);
+        settings.stayTimeMs = 1 << 30;
+        game.updateSettings(settings);
+        game.seedRandom(seed);
+        game.initGame();
+        game.m_state = GameState::Playing;
+        for (int i = 0; i < game.m_moles.size() && i < count; ++i) {
+            game.showMole(i, char('A' + rng.bounded(26)), 0);
+        }
+    }
+
+    // PoliceGame：固定种子下加载文章并让双方拉开一段距离
+    static void fillPolice(PoliceGame& game, quint32 seed) {
+        game.seedRandom(seed);
+        game.initGame();
+        game.m_state = GameState::Playing;
+        game.m_playerDistance = 120.0;
+        game.m_currentIndex = qMin(20, game.m_targetText.length());
+    }
+    // 模拟打对一个字：光标前进，下一帧重排输入条
+    static void policeAdvance(PoliceGame& game) {
+        game.m_currentIndex = (game.m_currentIndex + 1) % qMax(1, game.m_targetText.length());
+    }
+};
+
+#endif // BENCHACCESS_H
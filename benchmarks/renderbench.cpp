@@ -0,0 +1,192 @@
+﻿#include "benchaccess.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLPaintDevice>
+#include <QOffscreenSurface>
+#include <QScopedPointer>
+#include <QTextStream>
+#include <functional>
+
+// 离屏绘制基准：把每个游戏构造成固定种子的状态，循环调用 draw(QPainter&)，
+// 分别测 raster 引擎 (QImage) 和 OpenGL 引擎 (FBO)，输出 ns/帧 和 像素/秒。
+//
+// 用法：renderbench [--entities N] [--frames K] [--seed S] [--engine raster|opengl|both] [--json out.json]
+
+const int FRAME_W = 800;
+const int FRAME_H = 600;
+const int WARMUP_FRAMES = 50;
+
+struct RenderCase {
+    QString name;
+    GameBase* game;
+};
+
+struct RenderResult {
+    QString game;
+    QString engine;
+    int frames;
+    double nsPerFrame;
+    double pixelsPerSec;
+};
+
+// 在给定设备上连续绘制 frames 帧，返回总耗时 (ns)
+static qint64 timeFrames(QPaintDevice* device, GameBase* game, int frames, const std::function<void()>& sync) {
+    QPainter painter(device);
+    for (int i = 0; i < WARMUP_FRAMES; ++i) {
+        painter.save();
+        game->draw(painter);
+        painter.restore();
+    }
+    sync();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < frames; ++i) {
+        painter.save();
+        game->draw(painter);
+        painter.restore();
+    }
+    painter.end();
+    sync();
+    return timer.nsecsElapsed();
+}
+
+static RenderResult makeResult(const QString& game, const QString& engine, int frames, qint64 ns) {
+    RenderResult r;
+    r.game = game;
+    r.engine = engine;
+    r.frames = frames;
+    r.nsPerFrame = frames > 0 ? (double)ns / frames : 0.0;
+    r.pixelsPerSec = ns > 0 ? (double)FRAME_W * FRAME_H * frames / (ns / 1e9) : 0.0;
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offscreen draw() benchmark for every game");
+    parser.addHelpOption();
+    QCommandLineOption entitiesOpt("entities", "Entity count per game.", "N", "256");
+    QCommandLineOption framesOpt("frames", "Frames to draw per game and engine.", "K", "2000");
+    QCommandLineOption seedOpt("seed", "Random seed for the game state.", "S", "20240601");
+    QCommandLineOption engineOpt("engine", "raster, opengl or both.", "engine", "both");
+    QCommandLineOption jsonOpt("json", "Write results as JSON to this file.", "file");
+    parser.addOption(entitiesOpt);
+    parser.addOption(framesOpt);
+    parser.addOption(seedOpt);
+    parser.addOption(engineOpt);
+    parser.addOption(jsonOpt);
+    parser.process(app);
+
+    const int entities = qMax(0, parser.value(entitiesOpt).toInt());
+    const int frames = qMax(1, parser.value(framesOpt).toInt());
+    const quint32 seed = parser.value(seedOpt).toUInt();
+    const QString engine = parser.value(engineOpt);
+    const bool runRaster = (engine == "raster" || engine == "both");
+    bool runGl = (engine == "opengl" || engine == "both");
+
+    // 构造固定状态的游戏
+    SpaceGame space;
+    AppleGame apple;
+    FrogGame frog;
+    MoleGame mole;
+    PoliceGame police;
+    BenchAccess::fillSpace(space, entities, seed);
+    BenchAccess::fillApples(apple, entities, seed);
+    BenchAccess::fillFrogLeaves(frog, entities, seed);
+    BenchAccess::fillMoles(mole, entities, seed);
+    BenchAccess::fillPolice(police, seed);
+
+    QList<RenderCase> cases;
+    cases << RenderCase{ "space", &space } << RenderCase{ "apple", &apple } << RenderCase{ "frog", &frog }
+          << RenderCase{ "mole", &mole } << RenderCase{ "police", &police };
+
+    QList<RenderResult> results;
+
+    if (runRaster) {
+        QImage image(FRAME_W, FRAME_H, QImage::Format_ARGB32_Premultiplied);
+        for (const RenderCase& c : cases) {
+            qint64 ns = timeFrames(&image, c.game, frames, [] {});
+            results << makeResult(c.name, "raster", frames, ns);
+        }
+    }
+
+    if (runGl) {
+        QOffscreenSurface surface;
+        surface.create();
+        QOpenGLContext context;
+        if (!context.create() || !context.makeCurrent(&surface)) {
+            qWarning("renderbench: OpenGL context unavailable, skipping opengl engine");
+            runGl = false;
+        }
+        else {
+            QOpenGLFramebufferObjectFormat fboFormat;
+            fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+            fboFormat.setSamples(0);
+            QOpenGLFramebufferObject fbo(FRAME_W, FRAME_H, fboFormat);
+            fbo.bind();
+            QOpenGLPaintDevice device(FRAME_W, FRAME_H);
+            QOpenGLFunctions* gl = context.functions();
+            for (const RenderCase& c : cases) {
+                // glFinish 保证计时包含 GPU 实际完成的工作
+                qint64 ns = timeFrames(&device, c.game, frames, [gl] { gl->glFinish(); });
+                results << makeResult(c.name, "opengl", frames, ns);
+            }
+            fbo.release();
+            context.doneCurrent();
+        }
+    }
+
+    QTextStream out(stdout);
+    out << QString("entities=%1 frames=%2 seed=%3\n").arg(entities).arg(frames).arg(seed);
+    out << QString("%1 %2 %3 %4\n").arg("game", -8).arg("engine", -8).arg("ns/frame", 14).arg("Mpixels/s", 12);
+    for (const RenderResult& r : results) {
+        out << QString("%1 %2 %3 %4\n")
+            .arg(r.game, -8)
+            .arg(r.engine, -8)
+            .arg(r.nsPerFrame, 14, 'f', 0)
+            .arg(r.pixelsPerSec / 1e6, 12, 'f', 1);
+    }
+    out.flush();
+
+    if (parser.isSet(jsonOpt)) {
+        QJsonArray arr;
+        for (const RenderResult& r : results) {
+            QJsonObject o;
+            o["game"] = r.game;
+            o["engine"] = r.engine;
+            o["frames"] = r.frames;
+            o["ns_per_frame"] = r.nsPerFrame;
+            o["pixels_per_sec"] = r.pixelsPerSec;
+            arr.append(o);
+        }
+        QJsonObject root;
+        root["entities"] = entities;
+        root["frames"] = frames;
+        root["seed"] = (double)seed;
+        root["width"] = FRAME_W;
+        root["height"] = FRAME_H;
+        root["results"] = arr;
+
+        QFile file(parser.value(jsonOpt));
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(QJsonDocument(root).toJson());
+        }
+    }
+
+    return 0;
+}
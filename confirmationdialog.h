@@ -1,33 +1,34 @@
-﻿#ifndef CONFIRMATIONDIALOG_H
-#define CONFIRMATIONDIALOG_H
-
-#include <QDialog>
-#include <QLabel>
-#include "imagebutton.h"
-
-class ConfirmationDialog : public QDialog {
-    Q_OBJECT
-
-public:
-    // 对话框模式
-    enum Mode {
-        Mode_ExitGame,    // 退出确认
-        Mode_ApplySettings // 设置生效确认
-    };
-
-    explicit ConfirmationDialog(Mode mode, QWidget *parent = nullptr);
-
-
-protected:
-    void paintEvent(QPaintEvent *event) override;
-
-private:
-    void setupUI(Mode mode);
-
-    QPixmap m_bgPixmap;
-    QLabel* m_messageLabel;
-    ImageButton* m_btnConfirm; // 确认按钮 (退出 / 是)
-    ImageButton* m_btnCancel;  // 取消按钮 (继续 / 否)
-};
-
+﻿#ifndef CONFIRMATIONDIALOG_H
+#define CONFIRMATIONDIALOG_H
+
+#include "gamecore_global.h"
+#include <QDialog>
+#include <QLabel>
+#include "imagebutton.h"
+
+class GAMECORE_EXPORT ConfirmationDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    // 对话框模式
+    enum Mode {
+        Mode_ExitGame,    // 退出确认
+        Mode_ApplySettings // 设置生效确认
+    };
+
+    explicit ConfirmationDialog(Mode mode, QWidget *parent = nullptr);
+
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void setupUI(Mode mode);
+
+    QPixmap m_bgPixmap;
+    QLabel* m_messageLabel;
+    ImageButton* m_btnConfirm; // 确认按钮 (退出 / 是)
+    ImageButton* m_btnCancel;  // 取消按钮 (继续 / 否)
+};
+
 #endif // CONFIRMATIONDIALOG_H
\ No newline at end of file
@@ -0,0 +1,165 @@
+﻿#include "contentgenerator.h"
+#include "typinganalytics.h"
+#include "gamestats.h"
+#include <algorithm>
+
+const int REFRESH_INTERVAL_MS = 500;
+const quint32 MIN_ATTEMPTS = 5;       // 按过几次之后才相信该键的统计
+const quint32 MIN_BIGRAM_ATTEMPTS = 3;
+const double ERROR_BOOST = 4.0;       // 错误率 100% 的键权重 +4
+const double LATENCY_BOOST = 1.0;     // 比平均慢一倍的键权重 +1
+const double BIGRAM_BOOST = 2.0;
+const double MAX_WEIGHT = 5.0;        // 避免只剩几个字母
+const double CHANGE_THRESHOLD = 0.02; // 相对变化小于 2% 不重建；离 1 不到 2% 的取整为 1
+
+namespace {
+
+bool updateWeight(double& current, double next) {
+    // 取整为 1：玩家练好之后权重能回到正好 1，均匀抽样才能重新启用
+    if (qAbs(next - 1.0) <= CHANGE_THRESHOLD) next = 1.0;
+    if (next == current) return false;
+    if (next != 1.0 && qAbs(next - current) <= current * CHANGE_THRESHOLD) return false;
+    current = next;
+    return true;
+}
+
+QVector<double> toVector(const double* weights, int count) {
+    QVector<double> v(count);
+    for (int i = 0; i < count; ++i) v[i] = weights[i];
+    return v;
+}
+
+} // namespace
+
+ContentGenerator& ContentGenerator::instance() {
+    static ContentGenerator instance;
+    return instance;
+}
+
+ContentGenerator::Profile::Profile() : uniform(true) {
+    QVector<double> ones(LetterCount, 1.0);
+    for (int i = 0; i < LetterCount; ++i) letterWeights[i] = 1.0;
+    for (int i = 0; i < LetterCount * LetterCount; ++i) bigramWeights[i] = 1.0;
+    letterTable.build(ones);
+    for (AliasTable& table : bigramTables) table.build(ones);
+    std::fill(bigramBoost, bigramBoost + LetterCount * LetterCount, 1.0);
+}
+
+ContentGenerator::ContentGenerator() : m_revision(0), m_seenKeystrokes(0) {
+    m_player = GameStats::instance().playerName();
+}
+
+void ContentGenerator::switchPlayer(const QString& player) {
+    m_profiles.insert(m_player, m_profile);
+    m_profile = m_profiles.take(player); // 没见过的玩家得到默认构造的均匀权重
+    m_player = player;
+
+    // 之前的错误率和按键间隔属于上一个玩家，清空后从零开始统计
+    TypingAnalytics::instance().reset();
+    m_seenKeystrokes = 0;
+    m_revision++;
+}
+
+void ContentGenerator::refreshIfStale() {
+    const QString player = GameStats::instance().playerName();
+    if (player != m_player) switchPlayer(player);
+
+    if (m_refreshClock.isValid() && m_refreshClock.elapsed() < REFRESH_INTERVAL_MS) return;
+    m_refreshClock.start();
+
+    TypingMetrics metrics = TypingAnalytics::instance().metrics();
+    if (metrics.keystrokes == m_seenKeystrokes) return;
+    m_seenKeystrokes = metrics.keystrokes;
+    refresh(metrics);
+}
+
+void ContentGenerator::refresh(const TypingMetrics& m) {
+    Profile& p = m_profile;
+    bool changed = false;
+    bool uniform = true;
+
+    // 单键权重：数据不够的键保持原来的权重（新玩家是 1，换回来的玩家是他上次的）
+    bool lettersChanged = false;
+    for (int i = 0; i < LetterCount; ++i) {
+        const int key = 'A' + i;
+        double w = p.letterWeights[i];
+        if (m.keyAttempts[key] >= MIN_ATTEMPTS) {
+            w = 1.0 + ERROR_BOOST * m.keyErrorRate[key];
+            if (m.meanLatencyMs > 0.0 && m.keyLatencyMs[key] > 0.0) {
+                w += LATENCY_BOOST * qMax(0.0, m.keyLatencyMs[key] / m.meanLatencyMs - 1.0);
+            }
+            w = qMin(w, MAX_WEIGHT);
+        }
+        lettersChanged |= updateWeight(p.letterWeights[i], w);
+        if (p.letterWeights[i] != 1.0) uniform = false;
+    }
+    if (lettersChanged) {
+        p.letterTable.build(toVector(p.letterWeights, LetterCount));
+        changed = true;
+    }
+
+    // 字母组合：以前一个字母分行，只重建变化了的行
+    for (int a = 0; a < LetterCount; ++a) {
+        bool rowChanged = false;
+        double* row = p.bigramWeights + a * LetterCount;
+        for (int b = 0; b < LetterCount; ++b) {
+            const int bigram = TypingMetrics::bigramOf(a, b);
+            if (m.bigramAttempts[bigram] >= MIN_BIGRAM_ATTEMPTS) {
+                p.bigramBoost[bigram] = 1.0 + BIGRAM_BOOST * m.bigramErrorRate[bigram];
+            }
+            const double w = qMin(p.letterWeights[b] * p.bigramBoost[bigram], MAX_WEIGHT);
+            rowChanged |= updateWeight(row[b], w);
+            if (row[b] != 1.0) uniform = false;
+        }
+        if (rowChanged) {
+            p.bigramTables[a].build(toVector(row, LetterCount));
+            changed = true;
+        }
+    }
+
+    p.uniform = uniform;
+    if (changed) m_revision++;
+}
+
+char ContentGenerator::letter(GameRandom& rng, char previous) {
+    refreshIfStale();
+    if (m_profile.uniform) return 'A' + rng.bounded(LetterCount);
+
+    const int prev = previous >= 'A' && previous <= 'Z' ? previous - 'A' : -1;
+    const AliasTable& table = prev >= 0 ? m_profile.bigramTables[prev] : m_profile.letterTable;
+    return 'A' + table.sample(rng);
+}
+
+double ContentGenerator::wordWeight(const QString& word) const {
+    // 每个字母的权重取平均：有前一个字母时用组合权重
+    double total = 0.0;
+    int count = 0;
+    int prev = -1;
+    for (QChar c : word) {
+        const ushort u = c.toUpper().unicode();
+        const int letter = u >= 'A' && u <= 'Z' ? u - 'A' : -1;
+        if (letter >= 0) {
+            total += prev >= 0 ? bigramWeight(prev, letter) : m_profile.letterWeights[letter];
+            count++;
+        }
+        prev = letter;
+    }
+    return count > 0 ? total / count : 1.0;
+}
+
+QString ContentGenerator::WordSampler::next(GameRandom& rng, const QStringList& words) {
+    if (words.isEmpty()) return QString();
+
+    ContentGenerator& generator = ContentGenerator::instance();
+    generator.refreshIfStale();
+    if (generator.m_profile.uniform) return words[rng.bounded(words.size())];
+
+    if (!m_words.isSharedWith(words) || m_revision != generator.m_revision) {
+        m_words = words;
+        m_revision = generator.m_revision;
+        QVector<double> weights(words.size());
+        for (int i = 0; i < words.size(); ++i) weights[i] = generator.wordWeight(words[i]);
+        m_table.build(weights);
+    }
+    return m_words[m_table.sample(rng)];
+}
@@ -0,0 +1,77 @@
+﻿#ifndef CONTENTGENERATOR_H
+#define CONTENTGENERATOR_H
+
+#include "gamecore_global.h"
+#include "aliastable.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QStringList>
+
+struct TypingMetrics;
+
+// 出字/出词的内容生成器
+// 按 TypingAnalytics 记录的每键错误率、按键间隔和字母组合错误率给 A-Z 加权，
+// 玩家越容易按错、按得越慢的键出现得越多。抽样用别名表，每次 O(1)；
+// 新的统计数据最多每 500ms 读一次，只有权重确实变化的表才重建。
+// 还没有数据时与原来一样均匀随机。
+// 权重按玩家（GameStats 的当前玩家）分开保存：换人时换成这个人的权重，
+// 并清空 TypingAnalytics，之后的统计只来自新玩家的按键。只在 GUI 线程使用。
+class GAMECORE_EXPORT ContentGenerator {
+public:
+    static ContentGenerator& instance();
+
+    static const int LetterCount = 26;
+
+    // 下一个字母 'A'-'Z'；previous 是上一个生成的字母（没有传 0），用于字母组合加权
+    char letter(GameRandom& rng, char previous = 0);
+
+    // 当前玩家的权重（1 为普通键）
+    double letterWeight(int letter) const { return m_profile.letterWeights[letter]; }
+    double wordWeight(const QString& word) const;
+
+    // 立即按给定的统计数据更新当前玩家的权重（基准测试用）
+    void refresh(const TypingMetrics& metrics);
+
+    // 按权重抽词。词表由调用方持有，传入的列表换了（不再共享数据）或权重更新后才重建
+    class WordSampler {
+    public:
+        WordSampler() : m_revision(0) {}
+        QString next(GameRandom& rng, const QStringList& words);
+
+    private:
+        QStringList m_words;
+        quint32 m_revision;
+        AliasTable m_table;
+    };
+
+private:
+    ContentGenerator();
+    ContentGenerator(const ContentGenerator&) = delete;
+    ContentGenerator& operator=(const ContentGenerator&) = delete;
+
+    // 一个玩家的权重和抽样表
+    struct Profile {
+        Profile();
+
+        double letterWeights[LetterCount];
+        double bigramWeights[LetterCount * LetterCount];
+        AliasTable letterTable;
+        AliasTable bigramTables[LetterCount]; // 按前一个字母分表
+        bool uniform; // 所有权重都是 1
+        // 字母组合在单键权重之上的倍数；换回这个玩家后数据还不够时沿用
+        double bigramBoost[LetterCount * LetterCount];
+    };
+
+    void refreshIfStale();
+    void switchPlayer(const QString& player);
+    double bigramWeight(int prev, int letter) const { return m_profile.bigramWeights[prev * LetterCount + letter]; }
+
+    Profile m_profile;                 // 当前玩家
+    QString m_player;
+    QHash<QString, Profile> m_profiles; // 其他玩家，换回来时恢复
+    quint32 m_revision;  // 权重每变化一次（包括换人）加一
+    QElapsedTimer m_refreshClock;
+    quint64 m_seenKeystrokes;
+};
+
+#endif // CONTENTGENERATOR_H
@@ -1,60 +1,66 @@
-﻿#include "datamanager.h"
-#include <QDir>
-#include <QFile>
-#include <QTextStream>
-#include <QTextCodec>
-#include <QRandomGenerator>
-#include <QDebug>
-
-void DataManager::loadArticlesFromDir(const QString& dirPath) {
-    m_articles.clear();
-    QDir dir(dirPath);
-
-    QStringList filters;
-    filters << "*.txt";
-    dir.setNameFilters(filters);
-
-    QFileInfoList fileList = dir.entryInfoList();
-
-    QTextCodec* codec = QTextCodec::codecForName("GBK");
-    if (!codec) codec = QTextCodec::codecForName("UTF-8");
-    if (!codec) codec = QTextCodec::codecForLocale();
-
-    for (const QFileInfo& fileInfo : fileList) {
-        QFile file(fileInfo.absoluteFilePath());
-        if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            QByteArray data = file.readAll();
-
-            QString content;
-            if (codec) {
-                content = codec->toUnicode(data);
-            }
-            else {
-                content = QString::fromLocal8Bit(data); 
-            }
-
-            // 清洗文本：替换换行符为空格，去除首尾空白
-            content = content.replace("\r\n", " ").replace("\n", " ").replace("\r", " ").simplified();
-
-            if (!content.isEmpty()) {
-                m_articles.append(content);
-            }
-            file.close();
-        }
-    }
-
-    // 保底数据，防止文件读取全失败导致后续逻辑除以零
-    if (m_articles.isEmpty()) {
-        m_articles << "Technology is best when it brings people together";
-        m_articles << "Stay hungry stay foolish";
-        m_articles << "Knowledge is power";
-    }
-}
-
-QString DataManager::getRandomArticle() {
-    if (m_articles.isEmpty()) {
-        m_articles << "Ready Go";
-    }
-    int index = QRandomGenerator::global()->bounded(m_articles.size());
-    return m_articles[index];
+﻿#include "datamanager.h"
+#include "gametrace.h"
+#include <QDir>
+#include "textimport.h"
+#include <QDebug>
+
+DataManager& DataManager::instance() {
+    static DataManager instance;
+    return instance;
+}
+
+void DataManager::loadArticlesFromDir(const QString& dirPath) {
+    TRACE_SCOPE("DataManager::loadArticlesFromDir");
+    m_passages.clear();
+    m_fileArticles.clear();
+    QDir dir(dirPath);
+
+    QStringList filters;
+    filters << "*.txt";
+    dir.setNameFilters(filters);
+
+    QFileInfoList fileList = dir.entryInfoList();
+
+    // 编码识别和空白整理都在 TextImporter 里完成，没改过的文件直接取缓存
+    TextImporter& importer = TextImporter::instance();
+    for (const QFileInfo& fileInfo : fileList) {
+        QString content = importer.load(fileInfo.absoluteFilePath());
+        if (!content.isEmpty()) {
+            m_fileArticles.insert(fileInfo.absoluteFilePath(), m_passages.addArticle(content));
+        }
+    }
+
+    // 保底数据，防止文件读取全失败导致后续逻辑除以零
+    if (m_passages.articleCount() == 0) {
+        m_passages.addArticle("Technology is best when it brings people together");
+        m_passages.addArticle("Stay hungry stay foolish");
+        m_passages.addArticle("Knowledge is power");
+    }
+}
+
+int DataManager::loadArticleFile(const QString& path) {
+    TRACE_SCOPE("DataManager::loadArticleFile");
+    const QString key = QFileInfo(path).absoluteFilePath();
+    QString content = TextImporter::instance().load(key);
+    if (content.isEmpty()) return -1;
+
+    auto it = m_fileArticles.constFind(key);
+    if (it != m_fileArticles.constEnd()) {
+        // 文件改过：原地替换，旧内容不再留在索引里
+        if (!m_passages.articleMatches(*it, content)) m_passages.replaceArticle(*it, content);
+        return *it;
+    }
+
+    int article = m_passages.addArticle(content);
+    m_fileArticles.insert(key, article);
+    return article;
+}
+
+int DataManager::addArticle(const QString& text) {
+    if (text.isEmpty()) return -1;
+    // 本次运行已经载入过的直接复用
+    for (int i = 0; i < m_passages.articleCount(); ++i) {
+        if (m_passages.articleMatches(i, text)) return i;
+    }
+    return m_passages.addArticle(text);
 }
\ No newline at end of file
@@ -1,26 +1,33 @@
-﻿#ifndef DATAMANAGER_H
-#define DATAMANAGER_H
-
-#include <QString>
-#include <QStringList>
-#include <QVector>
-
-class DataManager {
-public:
-    static DataManager& instance() {
-        static DataManager instance;
-        return instance;
-    }
-
-    // 加载指定目录下的所有文章
-    void loadArticlesFromDir(const QString& dirPath);
-
-    // 随机获取一篇文章
-    QString getRandomArticle();
-
-private:
-    DataManager() {}
-    QStringList m_articles;
-};
-
+﻿#ifndef DATAMANAGER_H
+#define DATAMANAGER_H
+
+#include "gamecore_global.h"
+#include "passageindex.h"
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class GAMECORE_EXPORT DataManager {
+public:
+    static DataManager& instance();
+
+    // 加载指定目录下的所有文章
+    void loadArticlesFromDir(const QString& dirPath);
+
+    // 载入单个文件并切段，返回文章编号；读不到或为空返回 -1。
+    // 同一文件只切一次；文件改过时原地替换这篇文章，编号不变
+    int loadArticleFile(const QString& path);
+    // 直接加入一篇文章的内容（恢复快照时用），已有相同内容的返回原编号
+    int addArticle(const QString& text);
+
+    // 已载入文章的段落索引（目录里的文章和单独载入的文件）
+    const PassageIndex& passages() const { return m_passages; }
+
+private:
+    DataManager() {}
+    PassageIndex m_passages;
+    QHash<QString, int> m_fileArticles; // 路径 -> 文章编号
+};
+
 #endif // DATAMANAGER_H
\ No newline at end of file
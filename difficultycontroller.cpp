@@ -0,0 +1,94 @@
+﻿#include "difficultycontroller.h"
+#include "typinganalytics.h"
+#include <cmath>
+
+const int TICK_INTERVAL_MS = 1000;
+const double MIN_LEVEL = 0.5;
+const double MAX_LEVEL = 2.0;
+const double TARGET_ACCURACY = 0.92;
+const int MIN_KEYSTROKES = 3;        // 一个周期内按键太少（在观察、在等）时保持不变
+const double ACCURACY_ALPHA = 0.3;
+const double WPM_ALPHA = 0.05;
+const double DEAD_BAND = 0.02;       // 命中率在目标附近时不调，避免来回抖动
+const double GAIN_UP = 1.0;          // 每秒 level *= exp(gain * 偏差)
+const double GAIN_DOWN = 2.0;        // 减难比加难快
+const double OVERLOAD_WPM_RATIO = 0.75;
+
+DifficultyController::DifficultyController(QObject* parent)
+    : QObject(parent), m_enabled(false) {
+    reset();
+    m_timer.setInterval(TICK_INTERVAL_MS);
+    connect(&m_timer, &QTimer::timeout, this, [this]() { onTick(); });
+}
+
+void DifficultyController::reset() {
+    m_level = 1.0;
+    m_accuracy = -1.0;
+    m_wpmBaseline = -1.0;
+    m_lastKeystrokes = 0;
+    m_lastCorrect = 0;
+}
+
+DifficultyParams DifficultyController::paramsFor(double level) {
+    DifficultyParams params;
+    params.spawnRate = level;
+    params.speed = std::sqrt(level);
+    params.wordLength = std::sqrt(level);
+    return params;
+}
+
+void DifficultyController::setEnabled(bool enabled) {
+    if (m_enabled == enabled) return;
+    m_enabled = enabled;
+    reset();
+    if (m_game) m_game->setDifficultyParams(DifficultyParams());
+    if (m_enabled && m_game) m_timer.start();
+    else m_timer.stop();
+}
+
+void DifficultyController::attach(GameBase* game) {
+    if (m_game && m_game != game) m_game->setDifficultyParams(DifficultyParams());
+    m_game = game;
+    reset();
+    if (!m_game) {
+        m_timer.stop();
+        return;
+    }
+    m_game->setDifficultyParams(DifficultyParams());
+    if (m_enabled) m_timer.start();
+}
+
+void DifficultyController::onTick() {
+    if (!m_game || m_game->getState() != GameState::Playing) return;
+
+    int keystrokes = m_game->sessionKeystrokes();
+    int correct = m_game->sessionCorrectKeystrokes();
+    if (keystrokes < m_lastKeystrokes) {
+        // 新开了一局，计数已清零；level 保留，玩家水平不会因为重开而变
+        m_lastKeystrokes = 0;
+        m_lastCorrect = 0;
+    }
+    step(keystrokes - m_lastKeystrokes, correct - m_lastCorrect, TypingAnalytics::instance().metrics().wpm);
+    m_lastKeystrokes = keystrokes;
+    m_lastCorrect = correct;
+
+    DifficultyParams params = paramsFor(m_level);
+    if (params != m_game->difficultyParams()) m_game->setDifficultyParams(params);
+}
+
+void DifficultyController::step(int keystrokes, int correct, double wpm) {
+    if (keystrokes < MIN_KEYSTROKES) return;
+
+    const double sample = double(correct) / keystrokes;
+    m_accuracy = m_accuracy < 0.0 ? sample : m_accuracy + ACCURACY_ALPHA * (sample - m_accuracy);
+
+    double error = m_accuracy - TARGET_ACCURACY;
+    if (qAbs(error) < DEAD_BAND) error = 0.0;
+
+    // 命中率还行但速度明显低于平时：已经跟不上了，不再加难
+    if (m_wpmBaseline > 0.0 && wpm < m_wpmBaseline * OVERLOAD_WPM_RATIO) error = qMin(error, -DEAD_BAND);
+    m_wpmBaseline = m_wpmBaseline < 0.0 ? wpm : m_wpmBaseline + WPM_ALPHA * (wpm - m_wpmBaseline);
+
+    const double gain = error > 0.0 ? GAIN_UP : GAIN_DOWN;
+    m_level = qBound(MIN_LEVEL, m_level * std::exp(gain * error), MAX_LEVEL);
+}
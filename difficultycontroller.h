@@ -0,0 +1,50 @@
+﻿#ifndef DIFFICULTYCONTROLLER_H
+#define DIFFICULTYCONTROLLER_H
+
+#include "gamecore_global.h"
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include "gamebase.h"
+
+// 自适应难度
+// 每秒读一次玩家的实时水平（本局按键的命中率、TypingAnalytics 的滚动 WPM），
+// 调节一个难度系数 level：命中率高于目标就慢慢加难，低于目标或打字速度明显
+// 掉下来（跟不上了）就较快地减难，让玩家一直处在"有点紧张但跟得上"的状态。
+// level 统一换算成 DifficultyParams 交给当前游戏，游戏本身不需要难度表。
+class GAMECORE_EXPORT DifficultyController : public QObject {
+public:
+    explicit DifficultyController(QObject* parent = nullptr);
+
+    // 关闭时游戏恢复默认倍率
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    // 切换游戏时调用，nullptr 表示回到菜单；每次接管都从 1.0 重新开始
+    void attach(GameBase* game);
+
+    double level() const { return m_level; } // 0.5 - 2.0
+
+    // level -> 各项倍率：频率随 level 线性变化，速度和词长取平方根，
+    // 避免几项叠加后负荷增长过快
+    static DifficultyParams paramsFor(double level);
+
+    // 根据一个周期内的观测更新 level（定时器调用；基准测试可直接调用）
+    void step(int keystrokes, int correct, double wpm);
+
+private:
+    void onTick();
+    void reset();
+
+    QTimer m_timer;
+    QPointer<GameBase> m_game;
+    bool m_enabled;
+
+    double m_level;
+    double m_accuracy;      // 每周期命中率的指数平均，-1 表示还没有数据
+    double m_wpmBaseline;   // 慢速跟踪的 WPM，用来判断速度是否突然下降
+    int m_lastKeystrokes;   // 上一周期结束时的本局计数
+    int m_lastCorrect;
+};
+
+#endif // DIFFICULTYCONTROLLER_H
@@ -0,0 +1,157 @@
+﻿#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+#include <QVector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+// 紧凑存放的实体容器（slot map）
+// 实体按值连续存放，遍历就是顺序扫一块内存；删除时与末尾交换，O(1)。
+// 外部长期持有实体时用 Handle（槽位 + 代数），实体移动或被删除后
+// 旧句柄通过 get() 取到 nullptr，不会指向别的实体。
+//
+// kill() 只做标记，真正的移除留到 compact() 统一完成，这样遍历过程中
+// 可以随意 kill，下标和引用在本帧内都保持有效。
+// 注意：add() 可能导致重新分配，持有的 T& / T* 会失效，跨 add 请用句柄或下标。
+template <typename T>
+class EntityPool {
+public:
+    struct Handle {
+        int slot;
+        quint32 generation;
+
+        Handle() : slot(-1), generation(0) {}
+        Handle(int s, quint32 g) : slot(s), generation(g) {}
+        bool isNull() const { return slot < 0; }
+        bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const Handle& other) const { return !(*this == other); }
+    };
+
+    typedef typename QVector<T>::iterator iterator;
+    typedef typename QVector<T>::const_iterator const_iterator;
+
+    // 包括本帧已 kill、尚未 compact 的实体
+    int size() const { return m_items.size(); }
+    bool isEmpty() const { return m_items.isEmpty(); }
+    int pendingCount() const { return m_pending.size(); }
+
+    void reserve(int count) {
+        m_items.reserve(count);
+        m_itemSlot.reserve(count);
+        m_dead.reserve(count);
+        m_slots.reserve(count);
+    }
+
+    T& operator[](int index) { return m_items[index]; }
+    const T& operator[](int index) const { return m_items[index]; }
+    iterator begin() { return m_items.begin(); }
+    iterator end() { return m_items.end(); }
+    const_iterator begin() const { return m_items.begin(); }
+    const_iterator end() const { return m_items.end(); }
+
+    bool isAlive(int index) const { return !m_dead[index]; }
+    Handle handleAt(int index) const {
+        int slot = m_itemSlot[index];
+        return Handle(slot, m_slots[slot].generation);
+    }
+
+    Handle add(const T& value) {
+        int slot;
+        if (!m_freeSlots.isEmpty()) {
+            slot = m_freeSlots.takeLast();
+        }
+        else {
+            slot = m_slots.size();
+            m_slots.append(Slot());
+        }
+        m_slots[slot].index = m_items.size();
+        m_items.append(value);
+        m_itemSlot.append(slot);
+        m_dead.append(false);
+        return Handle(slot, m_slots[slot].generation);
+    }
+
+    // 句柄失效（实体已 kill 或槽位已复用）时返回 nullptr
+    T* get(const Handle& handle) {
+        int index = indexOf(handle);
+        return index >= 0 ? &m_items[index] : nullptr;
+    }
+    const T* get(const Handle& handle) const {
+        int index = indexOf(handle);
+        return index >= 0 ? &m_items[index] : nullptr;
+    }
+    int indexOf(const Handle& handle) const {
+        if (handle.slot < 0 || handle.slot >= m_slots.size()) return -1;
+        const Slot& s = m_slots[handle.slot];
+        return s.generation == handle.generation ? s.index : -1;
+    }
+
+    // 标记删除：句柄立即失效，实体留在原位直到 compact()
+    void killAt(int index) {
+        if (m_dead[index]) return;
+        m_dead[index] = true;
+        m_slots[m_itemSlot[index]].generation++;
+        m_pending.append(index);
+    }
+    bool kill(const Handle& handle) {
+        int index = indexOf(handle);
+        if (index < 0) return false;
+        killAt(index);
+        return true;
+    }
+
+    // 移除所有已标记的实体，代价只与本帧删除的数量成正比
+    // 从大到小处理下标，保证换进来的末尾元素一定是存活的
+    void compact() {
+        if (m_pending.isEmpty()) return;
+        std::sort(m_pending.begin(), m_pending.end(), std::greater<int>());
+        for (int index : m_pending) {
+            int slot = m_itemSlot[index];
+            m_slots[slot].index = -1;
+            m_freeSlots.append(slot);
+
+            int last = m_items.size() - 1;
+            if (index != last) {
+                m_items[index] = std::move(m_items[last]);
+                m_itemSlot[index] = m_itemSlot[last];
+                m_dead[index] = false;
+                m_slots[m_itemSlot[index]].index = index;
+            }
+            m_items.removeLast();
+            m_itemSlot.removeLast();
+            m_dead.removeLast();
+        }
+        m_pending.clear();
+    }
+
+    // 清空全部实体，已分配的容量保留，旧句柄全部失效
+    void clear() {
+        for (int slot : m_itemSlot) {
+            m_slots[slot].index = -1;
+            m_slots[slot].generation++;
+            m_freeSlots.append(slot);
+        }
+        m_items.clear();
+        m_itemSlot.clear();
+        m_dead.clear();
+        m_pending.clear();
+    }
+
+private:
+    struct Slot {
+        int index;           // 在 m_items 中的位置，空闲时为 -1
+        quint32 generation;  // 每次 kill / clear 递增，使旧句柄失效
+
+        Slot() : index(-1), generation(0) {}
+    };
+
+    QVector<T> m_items;
+    QVector<int> m_itemSlot;  // m_items[i] 占用的槽位
+    QVector<bool> m_dead;     // 已 kill、等待 compact
+    QVector<Slot> m_slots;
+    QVector<int> m_freeSlots;
+    QVector<int> m_pending;   // 等待 compact 的下标
+};
+
+#endif // ENTITYPOOL_H
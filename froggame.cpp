@@ -1,501 +1,622 @@
-﻿#include "froggame.h"
-#include <QRandomGenerator>
-#include <QDebug>
-#include <QtMath>
-#include <QFile>
-#include <QCoreApplication>
-#include <QDir>
-
-// 配置
-const int GAME_FPS = 60;
-const int SCREEN_WIDTH = 800;
-const int SCREEN_HEIGHT = 600;
-
-const int START_BANK_Y = 500;
-const int ROW_Y[] = { 400, 300, 200 };
-const int GOAL_BANK_Y = 100;
-
-const QStringList DEFAULT_WORDS = {
-    "data", "node", "tree", "list", "code", "byte", "bit", "loop"
-};
-
-FrogGame::FrogGame(QObject* parent) : GameBase(parent) {
-    // 资源加载
-    m_bgPixmap.load(":/img/frog_background.png");
-    m_leafPixmap.load(":/img/frog_leaf.png");
-
-    m_frogBack1.load(":/img/frog_back_1.png");
-    m_frogBack2.load(":/img/frog_back_2.png");
-    m_frogFront1.load(":/img/frog_front_1.png");
-    m_frogFront2.load(":/img/frog_front_2.png");
-
-    m_jumpSound = new QSoundEffect(this);
-    m_jumpSound->setSource(QUrl::fromLocalFile(":/snd/frog_jump.wav"));
-    m_splashSound = new QSoundEffect(this);
-    m_splashSound->setSource(QUrl::fromLocalFile(":/snd/mouse_away.wav"));
-    m_successSound = new QSoundEffect(this);
-    m_successSound->setSource(QUrl::fromLocalFile(":/snd/upgrade.wav"));
-    m_bgMusic = new QSoundEffect(this);
-    m_bgMusic->setSource(QUrl::fromLocalFile(":/snd/frog_bg.wav"));
-    m_bgMusic->setLoopCount(QSoundEffect::Infinite);
-
-    m_physicsTimer = new QTimer(this);
-    m_physicsTimer->setInterval(1000 / GAME_FPS);
-    connect(m_physicsTimer, &QTimer::timeout, this, &FrogGame::onGameTick);
-
-    m_animTimer = new QTimer(this);
-    m_animTimer->setInterval(1000);
-    connect(m_animTimer, &QTimer::timeout, this, &FrogGame::onAnimTick);
-    m_isCroaking = false;
-
-    m_settings.difficulty = 1;
-    m_settings.dictionaryFile = "4W.ID";
-    m_wordList = DEFAULT_WORDS;
-}
-
-FrogGame::~FrogGame() {
-    qDeleteAll(m_leaves);
-    m_leaves.clear();
-}
-
-void FrogGame::updateSettings(const FrogSettingsData& settings) {
-    m_settings = settings;
-    loadDictionary(m_settings.dictionaryFile);
-}
-
-void FrogGame::retreatFrog() {
-    // 逻辑：回到上一行
-    // Row 2 -> Row 1 (最新)
-    // Row 1 -> Row 0 (最新)
-    // Row 0 -> Bank (-1)
-
-    int targetRow = m_currentRow - 1;
-
-    if (targetRow < 0) {
-        // 回到岸边
-        m_currentRow = -1;
-        m_currentLeaf = nullptr;
-        m_frogPos = QPointF(SCREEN_WIDTH / 2, START_BANK_Y);
-        // 输入缓冲清空
-        m_inputBuffer.clear();
-        m_lockedLeaf = nullptr;
-        return;
-    }
-
-    // 寻找 targetRow 中“最新生成”的荷叶
-    // 由于 m_leaves 是 append 的，最新的在列表末尾
-    LotusLeaf* targetLeaf = nullptr;
-
-    for (int i = m_leaves.size() - 1; i >= 0; --i) {
-        if (m_leaves[i]->row == targetRow) {
-            // 还需要确保它在屏幕内，或者至少青蛙能站上去
-            targetLeaf = m_leaves[i];
-            break; // 找到最新的一个就停止
-        }
-    }
-
-    if (targetLeaf) {
-        m_currentRow = targetRow;
-        m_currentLeaf = targetLeaf;
-        m_frogPos.setX(targetLeaf->x);
-        m_frogPos.setY(ROW_Y[targetRow]);
-        // 重置锁定状态，因为换了荷叶
-        m_inputBuffer.clear();
-        m_lockedLeaf = nullptr;
-    }
-    else {
-        // 极端情况：上一排居然没叶子？那只能回岸边了
-        m_currentRow = -1;
-        m_currentLeaf = nullptr;
-        m_frogPos = QPointF(SCREEN_WIDTH / 2, START_BANK_Y);
-        m_inputBuffer.clear();
-        m_lockedLeaf = nullptr;
-    }
-}
-
-void FrogGame::loadDictionary(const QString& filename) {
-    QString path = QCoreApplication::applicationDirPath() + "/Data/English/T_WORD/Dictionary/" + filename;
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        if (m_wordList.isEmpty()) m_wordList = DEFAULT_WORDS;
-        return;
-    }
-    QByteArray data = file.readAll();
-    file.close();
-    QStringList newWords;
-    QString currentWord;
-    for (char c : data) {
-        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '\'' || c == '-') {
-            currentWord.append(c);
-        }
-        else {
-            if (currentWord.length() >= 2) {
-                newWords.append(currentWord.toLower());
-            }
-            currentWord.clear();
-        }
-    }
-    if (currentWord.length() >= 2) newWords.append(currentWord.toLower());
-
-    if (!newWords.isEmpty()) m_wordList = newWords;
-    else if (m_wordList.isEmpty()) m_wordList = DEFAULT_WORDS;
-}
-
-void FrogGame::initGame() {
-    m_state = GameState::Ready;
-    m_score = 0;
-
-    m_successCount = 0;
-
-    if (m_wordList.size() <= DEFAULT_WORDS.size()) {
-        loadDictionary(m_settings.dictionaryFile);
-    }
-
-    qDeleteAll(m_leaves);
-    m_leaves.clear();
-    resetFrog();
-    emit scoreChanged(0);
-}
-
-void FrogGame::startGame() {
-    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
-        initGame();
-        m_state = GameState::Playing;
-        m_physicsTimer->start();
-        m_animTimer->start();
-        m_bgMusic->play();
-
-        double baseSpeed = 0.5 + (m_settings.difficulty - 1) * 0.4;
-        double speeds[] = { baseSpeed, -baseSpeed * 1.3, baseSpeed * 1.6 };
-        for (int r = 0; r < 3; r++) {
-            int positions[] = { 160, 400, 640 };
-            for (int x : positions) {
-                QString w = m_wordList[QRandomGenerator::global()->bounded(m_wordList.size())];
-                m_leaves.append(new LotusLeaf(r, x, speeds[r], w));
-            }
-        }
-    }
-}
-
-void FrogGame::stopGame() {
-    m_state = GameState::GameOver;
-    m_physicsTimer->stop();
-    m_animTimer->stop();
-    m_bgMusic->stop();
-    qDeleteAll(m_leaves);
-    m_leaves.clear();
-}
-
-void FrogGame::onAnimTick() {
-    m_isCroaking = !m_isCroaking;
-}
-
-void FrogGame::spawnLeaves() {
-    double baseSpeed = 0.5 + (m_settings.difficulty - 1) * 0.4;
-    double speeds[] = { baseSpeed, -baseSpeed * 1.3, baseSpeed * 1.6 };
-    double minGap = 260.0;
-    for (int r = 0; r < 3; ++r) {
-        double rightMost = -9999; double leftMost = 9999; bool hasLeaf = false;
-        for (LotusLeaf* leaf : m_leaves) {
-            if (leaf->row == r) {
-                if (leaf->x > rightMost) rightMost = leaf->x;
-                if (leaf->x < leftMost) leftMost = leaf->x;
-                hasLeaf = true;
-            }
-        }
-        bool needSpawn = false; double spawnX = 0;
-        if (speeds[r] > 0) {
-            if (!hasLeaf || leftMost > (minGap - 100)) { spawnX = -100; needSpawn = true; }
-        }
-        else {
-            if (!hasLeaf || rightMost < (SCREEN_WIDTH - minGap + 100)) { spawnX = SCREEN_WIDTH + 100; needSpawn = true; }
-        }
-        if (needSpawn) {
-            if (QRandomGenerator::global()->bounded(100) < 15) {
-                QString w = m_wordList[QRandomGenerator::global()->bounded(m_wordList.size())];
-                m_leaves.append(new LotusLeaf(r, spawnX, speeds[r], w));
-            }
-        }
-    }
-}
-
-void FrogGame::onGameTick() {
-    spawnLeaves();
-    for (auto it = m_leaves.begin(); it != m_leaves.end(); ) {
-        LotusLeaf* leaf = *it;
-        leaf->x += leaf->speed;
-
-        if (leaf->x < -200 || leaf->x > SCREEN_WIDTH + 200) {
-            if (m_currentLeaf == leaf) {
-                // 青蛙在上面 -> 触发撤退
-                m_splashSound->play(); 
-                retreatFrog(); // 回到上一步
-            }
-
-            // 如果锁定的荷叶出去了，解锁
-            if (m_lockedLeaf == leaf) {
-                m_lockedLeaf = nullptr;
-                m_inputBuffer.clear();
-            }
-
-            delete leaf;
-            it = m_leaves.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
-    if (m_currentLeaf) {
-        m_frogPos.setX(m_currentLeaf->x);
-        m_frogPos.setY(ROW_Y[m_currentLeaf->row]);
-    }
-}
-
-void FrogGame::handleKeyPress(QKeyEvent* event) {
-    if (m_state != GameState::Playing) return;
-    if (event->key() == Qt::Key_Backspace) {
-        if (!m_inputBuffer.isEmpty()) m_inputBuffer.chop(1);
-        return;
-    }
-
-    QString text = event->text(); 
-    if (text.isEmpty() || text.length() > 1) return;
-
-
-    checkInput(text);
-}
-
-void FrogGame::resetFrog() {
-    m_currentRow = -1;
-    m_currentLeaf = nullptr;
-    m_inputBuffer.clear();
-
-    m_lockedLeaf = nullptr;
-    m_isGoalLocked = false;
-
-    m_frogPos = QPointF(SCREEN_WIDTH / 2, START_BANK_Y);
-    m_goalWord = m_wordList[QRandomGenerator::global()->bounded(m_wordList.size())];
-}
-
-void FrogGame::pauseGame() {
-    if (m_state == GameState::Playing) {
-        m_state = GameState::Paused;
-        m_physicsTimer->stop();
-        m_bgMusic->stop();
-    }
-    else if (m_state == GameState::Paused) {
-        m_state = GameState::Playing;
-        m_physicsTimer->start();
-        m_bgMusic->play();
-    }
-}
-
-
-void FrogGame::checkInput(const QString& key) {
-    int targetRow = m_currentRow + 1;
-
-    if (m_isGoalLocked) {
-        int nextIdx = m_inputBuffer.length();
-        if (nextIdx < m_goalWord.length() && m_goalWord.at(nextIdx) == key.at(0)) {
-            m_inputBuffer += key;
-            if (m_inputBuffer == m_goalWord) {
-                m_successSound->play();
-                m_score += 500;
-                m_successCount++;
-                emit scoreChanged(m_score);
-
-                // 成功了一只，是否全部完成？
-                if (m_successCount >= 5) { // 总共5只
-                    stopGame();
-                    emit gameFinished(m_score, true); // 唯一的结算界面
-                }
-                else {
-                    resetFrog(); // 下一只
-                }
-            }
-        }
-        return;
-    }
-
-    if (m_lockedLeaf) {
-        // ... (原代码保持不变) ...
-        int nextIdx = m_inputBuffer.length();
-        if (nextIdx < m_lockedLeaf->word.length() && m_lockedLeaf->word.at(nextIdx) == key.at(0)) {
-            m_inputBuffer += key;
-            if (m_inputBuffer == m_lockedLeaf->word) {
-                // Jump!
-                m_currentRow = m_lockedLeaf->row;
-                m_currentLeaf = m_lockedLeaf;
-                m_frogPos.setX(m_currentLeaf->x);
-                m_frogPos.setY(ROW_Y[m_currentLeaf->row]);
-
-                m_score += m_lockedLeaf->word.length() * 10;
-                m_jumpSound->play();
-                emit scoreChanged(m_score);
-
-                m_inputBuffer.clear();
-                m_lockedLeaf = nullptr;
-            }
-        }
-        return;
-    }
-
-    // 2. 未锁定状态 - 寻找目标
-
-    // Case A: 终点 (Row 3)
-    if (targetRow == 3) {
-        if (m_goalWord.startsWith(key)) {
-            m_isGoalLocked = true;
-            m_inputBuffer += key;
-            if (m_inputBuffer == m_goalWord) {
-                // Instant win logic...
-                m_successSound->play();
-                m_score += 500;
-                m_successCount++;
-                emit scoreChanged(m_score);
-                if (m_successCount >= 5) { stopGame(); emit gameFinished(m_score, true); }
-                else resetFrog();
-            }
-        }
-        return;
-    }
-
-    // Case B: 下一排荷叶 (修改为倒序遍历)
-    // 【修改点】从后往前遍历，实现“优先绑定后生成的单词”
-    for (int i = m_leaves.size() - 1; i >= 0; --i) {
-        LotusLeaf* leaf = m_leaves[i];
-
-        if (leaf->row == targetRow && leaf->x > 50 && leaf->x < SCREEN_WIDTH - 50) {
-            if (leaf->word.startsWith(key)) {
-                m_lockedLeaf = leaf; // 锁定
-                m_inputBuffer += key;
-                if (m_inputBuffer == leaf->word) {
-                    // Instant jump logic...
-                    m_currentRow = leaf->row;
-                    m_currentLeaf = leaf;
-                    m_frogPos.setX(leaf->x);
-                    m_frogPos.setY(ROW_Y[leaf->row]);
-                    m_score += 10;
-                    m_jumpSound->play();
-                    emit scoreChanged(m_score);
-                    m_inputBuffer.clear();
-                    m_lockedLeaf = nullptr;
-                }
-                return;
-            }
-        }
-    }
-}
-
-void FrogGame::draw(QPainter& painter) {
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    if (!m_bgPixmap.isNull()) {
-        painter.drawPixmap(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, m_bgPixmap);
-    }
-    else {
-        painter.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, QColor(65, 105, 225));
-    }
-
-    // 绘制终点单词
-    painter.setFont(QFont("Arial", 20, QFont::Bold));
-
-    // 判定是否绘制高亮
-    bool isGoalActive = (m_currentRow == 2) && (m_isGoalLocked || (m_inputBuffer.isEmpty() && m_lockedLeaf == nullptr));
-
-    if (isGoalActive && !m_inputBuffer.isEmpty() && m_isGoalLocked) {
-        // 终点被锁定且正在输入
-        int w = painter.fontMetrics().horizontalAdvance(m_goalWord);
-        int startX = (SCREEN_WIDTH - w) / 2;
-        int textY = GOAL_BANK_Y + 10;
-
-        // 已输入：深蓝
-        painter.setPen(Qt::darkBlue);
-        painter.drawText(startX, textY, m_inputBuffer);
-
-        // 未输入：红
-        int typedW = painter.fontMetrics().horizontalAdvance(m_inputBuffer);
-        painter.setPen(Qt::red);
-        painter.drawText(startX + typedW, textY, m_goalWord.mid(m_inputBuffer.length()));
-    }
-    else {
-        // 普通显示 (白色)
-        painter.setPen(Qt::white);
-        painter.drawText(QRect(0, GOAL_BANK_Y - 20, SCREEN_WIDTH, 40), Qt::AlignCenter, m_goalWord);
-    }
-
-    // 绘制荷叶
-    for (LotusLeaf* leaf : m_leaves) {
-        if (!m_leafPixmap.isNull()) {
-            painter.drawPixmap(leaf->x - m_leafPixmap.width() / 2,
-                ROW_Y[leaf->row] - m_leafPixmap.height() / 2,
-                m_leafPixmap);
-        }
-
-        // 字体改小
-        painter.setFont(QFont("Arial", 12, QFont::Bold));
-        int textY = ROW_Y[leaf->row] + 5;
-
-        // 判定该荷叶是否被锁定高亮
-        // 条件：它是锁定的荷叶，或者 输入为空且符合行号要求
-        bool isTarget = (leaf == m_lockedLeaf);
-
-        if (isTarget) {
-            QFontMetrics fm(painter.font());
-            int totalW = fm.horizontalAdvance(leaf->word);
-            int startX = leaf->x - totalW / 2;
-
-            // 已输入：深蓝
-            painter.setPen(Qt::darkBlue);
-            painter.drawText(startX, textY, m_inputBuffer);
-
-            // 未输入：红
-            int typedW = fm.horizontalAdvance(m_inputBuffer);
-            painter.setPen(Qt::red);
-            painter.drawText(startX + typedW, textY, leaf->word.mid(m_inputBuffer.length()));
-        }
-        else {
-            // 普通：黑色
-            painter.setPen(Qt::black);
-            // 扩大文本框宽度
-            QRect textRect(leaf->x - 70, ROW_Y[leaf->row] - 20, 140, 40);
-            painter.drawText(textRect, Qt::AlignCenter, leaf->word);
-        }
-    }
-
-    // 绘制青蛙
-    QPixmap* currentFrogPix = m_isCroaking ? &m_frogBack2 : &m_frogBack1;
-    if (currentFrogPix && !currentFrogPix->isNull()) {
-        painter.drawPixmap(m_frogPos.x() - currentFrogPix->width() / 2,
-            m_frogPos.y() - currentFrogPix->height() / 2,
-            *currentFrogPix);
-    }
-
-    // 绘制剩余青蛙（岸边等待）
-    // 注意：m_frogsRemaining 包含当前正在跳的这一只。
-    // 所以岸边等待的数量是 m_frogsRemaining - 1
-    int waitingFrogs = 5 - m_successCount - 1;
-    if (waitingFrogs < 0) waitingFrogs = 0; // 保护一下
-
-    for (int i = 0; i < waitingFrogs; ++i) {
-        int fx = SCREEN_WIDTH - 40 - (i * 35);
-        int fy = SCREEN_HEIGHT - 40;
-        if (currentFrogPix && !currentFrogPix->isNull())
-            painter.drawPixmap(fx, fy, 25, 25, *currentFrogPix);
-    }
-
-    // 绘制对岸青蛙
-    QPixmap* goalFrogPix = m_isCroaking ? &m_frogFront2 : &m_frogFront1;
-    int startGoalX = 50;
-    int gapGoal = 50;
-    for (int i = 0; i < m_successCount; ++i) {
-        int gx = startGoalX + i * gapGoal;
-        if (goalFrogPix && !goalFrogPix->isNull()) {
-            painter.drawPixmap(gx, 40, 40, 40, *goalFrogPix);
-        }
-    }
-
-    painter.setPen(Qt::white);
-    painter.setFont(QFont("Microsoft YaHei", 14, QFont::Bold));
-    painter.drawText(20, 40, QString("Score: %1").arg(m_score));
+﻿#include "froggame.h"
+#include "gametrace.h"
+#include "assetcache.h"
+#include "spritebatch.h"
+#include "audiomixer.h"
+#include <QDebug>
+#include <QtMath>
+#include <QFile>
+#include <QCoreApplication>
+#include <QDir>
+
+// 配置
+const int GAME_FPS = 60;
+
+const int START_BANK_Y = 500;
+const int ROW_Y[] = { 400, 300, 200 };
+const int GOAL_BANK_Y = 100;
+
+const QStringList DEFAULT_WORDS = {
+    "data", "node", "tree", "list", "code", "byte", "bit", "loop"
+};
+
+FrogGame::FrogGame(QObject* parent) : GameBase(parent) {
+    // 资源加载
+    m_bgPixmap.load(":/img/frog_background.png");
+    m_leafPixmap.load(":/img/frog_leaf.png");
+
+    m_frogBack1.load(":/img/frog_back_1.png");
+    m_frogBack2.load(":/img/frog_back_2.png");
+    m_frogFront1.load(":/img/frog_front_1.png");
+    m_frogFront2.load(":/img/frog_front_2.png");
+
+    m_jumpSound = AudioMixer::instance().load(":/snd/frog_jump.wav");
+    m_splashSound = AudioMixer::instance().load(":/snd/mouse_away.wav");
+    m_successSound = AudioMixer::instance().load(":/snd/upgrade.wav");
+
+    m_physicsTimer = new QTimer(this);
+    m_physicsTimer->setInterval(1000 / GAME_FPS);
+    connect(m_physicsTimer, &QTimer::timeout, this, &FrogGame::onGameTick);
+
+    m_animTimer = new QTimer(this);
+    m_animTimer->setInterval(1000);
+    connect(m_animTimer, &QTimer::timeout, this, &FrogGame::onAnimTick);
+    m_isCroaking = false;
+    m_nextLeafId = 0;
+
+    m_settings.difficulty = 1;
+    m_settings.dictionaryFile = "4W.ID";
+    m_wordList = DEFAULT_WORDS;
+}
+
+FrogGame::~FrogGame() {
+}
+
+void FrogGame::updateSettings(const FrogSettingsData& settings) {
+    m_settings = settings;
+    loadDictionary(m_settings.dictionaryFile);
+}
+
+const GameCapabilities& FrogGame::capabilities() const {
+    // 青蛙主题的按钮贴图
+    static const GameCapabilities caps = [] {
+        GameCapabilities c;
+        c.resultTheme = QStringLiteral("frog");
+        c.hud.start = HudButton::make(QPoint(160, 480), ":/img/frog_start.png", ":/img/frog_start_hover.png", ":/img/frog_start_pressed.png");
+        c.hud.pause = HudButton::make(QPoint(120, 510), ":/img/frog_pause.png", ":/img/frog_pause_hover.png", ":/img/frog_pause_pressed.png");
+        c.hud.end = HudButton::make(QPoint(200, 530), ":/img/frog_end.png", ":/img/frog_end_hover.png", ":/img/frog_end_pressed.png");
+        c.hud.settings = HudButton::make(QPoint(150, 550), ":/img/frog_setting.png", ":/img/frog_setting_hover.png", ":/img/frog_setting_pressed.png");
+        c.hud.quit = HudButton::make(QPoint(20, 550), ":/img/frog_exit.png", ":/img/frog_exit_hover.png", ":/img/frog_exit_pressed.png");
+        c.supportsSnapshots = true;
+        return c;
+    }();
+    return caps;
+}
+
+GameBase::SettingsResult FrogGame::execSettings(QWidget* parent) {
+    if (!m_settingsDialog) m_settingsDialog = new FrogGameSettings(parent);
+
+    FrogSettingsData oldSettings = m_settingsDialog->getSettings();
+    if (TRACE_EXEC(*m_settingsDialog, "FrogGameSettings::exec") != QDialog::Accepted) return SettingsRejected;
+
+    // 难度或词库变了才需要重启
+    m_pendingSettings = m_settingsDialog->getSettings();
+    bool changed = (oldSettings.difficulty != m_pendingSettings.difficulty) ||
+        (oldSettings.dictionaryFile != m_pendingSettings.dictionaryFile);
+    return changed ? SettingsChanged : SettingsUnchanged;
+}
+
+void FrogGame::retreatFrog() {
+    // 逻辑：回到上一行
+    // Row 2 -> Row 1 (最新)
+    // Row 1 -> Row 0 (最新)
+    // Row 0 -> Bank (-1)
+
+    int targetRow = m_currentRow - 1;
+
+    if (targetRow < 0) {
+        // 回到岸边
+        m_currentRow = -1;
+        m_currentLeaf = LeafHandle();
+        m_frogPos = QPointF(SCREEN_WIDTH / 2, START_BANK_Y);
+        // 输入缓冲清空
+        m_inputBuffer.clear();
+        m_lockedLeaf = LeafHandle();
+        return;
+    }
+
+    // 寻找 targetRow 中“最新生成”的荷叶（id 最大）
+    // 本帧已移出屏幕、等待移除的荷叶不算
+    int targetIndex = -1;
+
+    for (int i = 0; i < m_leaves.size(); ++i) {
+        if (m_leaves.isAlive(i) && m_leaves[i].row == targetRow) {
+            if (targetIndex < 0 || m_leaves[i].id > m_leaves[targetIndex].id) targetIndex = i;
+        }
+    }
+
+    if (targetIndex >= 0) {
+        const LotusLeaf* targetLeaf = &m_leaves[targetIndex];
+        m_currentRow = targetRow;
+        m_currentLeaf = m_leaves.handleAt(targetIndex);
+        m_frogPos.setX(targetLeaf->x);
+        m_frogPos.setY(ROW_Y[targetRow]);
+        // 重置锁定状态，因为换了荷叶
+        m_inputBuffer.clear();
+        m_lockedLeaf = LeafHandle();
+    }
+    else {
+        // 极端情况：上一排居然没叶子？那只能回岸边了
+        m_currentRow = -1;
+        m_currentLeaf = LeafHandle();
+        m_frogPos = QPointF(SCREEN_WIDTH / 2, START_BANK_Y);
+        m_inputBuffer.clear();
+        m_lockedLeaf = LeafHandle();
+    }
+}
+
+void FrogGame::loadDictionary(const QString& filename) {
+    TRACE_SCOPE("FrogGame::loadDictionary");
+    QString path = QCoreApplication::applicationDirPath() + "/Data/English/T_WORD/Dictionary/" + filename;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (m_wordList.isEmpty()) m_wordList = DEFAULT_WORDS;
+        return;
+    }
+    QByteArray data = file.readAll();
+    file.close();
+    QStringList newWords;
+    QString currentWord;
+    for (char c : data) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '\'' || c == '-') {
+            currentWord.append(c);
+        }
+        else {
+            if (currentWord.length() >= 2) {
+                newWords.append(currentWord.toLower());
+            }
+            currentWord.clear();
+        }
+    }
+    if (currentWord.length() >= 2) newWords.append(currentWord.toLower());
+
+    if (!newWords.isEmpty()) m_wordList = newWords;
+    else if (m_wordList.isEmpty()) m_wordList = DEFAULT_WORDS;
+}
+
+LeafHandle FrogGame::addLeaf(int row, double x, double speed, const QString& word) {
+    LotusLeaf leaf(row, x, speed, word);
+    leaf.id = m_nextLeafId++;
+    return m_leaves.add(leaf);
+}
+
+QString FrogGame::pickWord() {
+    const double scale = m_difficultyParams.wordLength;
+    if (scale == 1.0) return m_wordSampler.next(m_rng, m_wordList);
+
+    // 抽几个候选，取长度最接近"候选平均长度 x 倍率"的一个：
+    // 不需要词表的长度分布，换了词典也同样适用
+    const int Candidates = 4;
+    QString candidates[Candidates];
+    double total = 0.0;
+    for (int i = 0; i < Candidates; ++i) {
+        candidates[i] = m_wordSampler.next(m_rng, m_wordList);
+        total += candidates[i].length();
+    }
+    const double target = total / Candidates * scale;
+    int best = 0;
+    for (int i = 1; i < Candidates; ++i) {
+        if (qAbs(candidates[i].length() - target) < qAbs(candidates[best].length() - target)) best = i;
+    }
+    return candidates[best];
+}
+
+void FrogGame::initGame() {
+    m_state = GameState::Ready;
+    m_score = 0;
+
+    m_successCount = 0;
+
+    if (m_wordList.size() <= DEFAULT_WORDS.size()) {
+        loadDictionary(m_settings.dictionaryFile);
+    }
+
+    m_leaves.clear();
+    resetFrog();
+    emit scoreChanged(0);
+}
+
+void FrogGame::startGame() {
+    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
+        initGame();
+        m_state = GameState::Playing;
+        beginSession();
+        m_physicsTimer->start();
+        m_animTimer->start();
+        AudioMixer::instance().playMusic(":/snd/frog_bg.wav");
+
+        double baseSpeed = 0.5 + (m_settings.difficulty - 1) * 0.4;
+        double speeds[] = { baseSpeed, -baseSpeed * 1.3, baseSpeed * 1.6 };
+        for (int r = 0; r < 3; r++) {
+            int positions[] = { 160, 400, 640 };
+            for (int x : positions) {
+                QString w = pickWord();
+                addLeaf(r, x, speeds[r], w);
+            }
+        }
+    }
+}
+
+void FrogGame::stopGame() {
+    m_state = GameState::GameOver;
+    m_physicsTimer->stop();
+    m_animTimer->stop();
+    AudioMixer::instance().stopMusic();
+    m_leaves.clear();
+}
+
+void FrogGame::saveState(QDataStream& out) const {
+    out << m_settings.difficulty << m_settings.dictionaryFile << m_settings.dictionaryName
+        << m_nextLeafId << m_successCount << m_currentRow << m_frogPos
+        << m_goalWord << m_inputBuffer << m_isGoalLocked << m_isCroaking;
+
+    // 荷叶按存活顺序写出，青蛙所在和锁定的荷叶记成这个顺序里的序号（没有为 -1）
+    qint32 count = 0, current = -1, locked = -1;
+    for (int i = 0; i < m_leaves.size(); ++i) {
+        if (!m_leaves.isAlive(i)) continue;
+        if (m_leaves.handleAt(i) == m_currentLeaf) current = count;
+        if (m_leaves.handleAt(i) == m_lockedLeaf) locked = count;
+        count++;
+    }
+    out << count << current << locked;
+    for (int i = 0; i < m_leaves.size(); ++i) {
+        if (!m_leaves.isAlive(i)) continue;
+        const LotusLeaf& leaf = m_leaves[i];
+        out << leaf.id << leaf.row << leaf.x << leaf.speed << leaf.word;
+    }
+}
+
+bool FrogGame::restoreState(QDataStream& in) {
+    // 设置先读到局部变量，全部校验通过后才生效（词库也到那时才换）
+    FrogSettingsData settings;
+    qint32 count, current, locked;
+    in >> settings.difficulty >> settings.dictionaryFile >> settings.dictionaryName
+        >> m_nextLeafId >> m_successCount >> m_currentRow >> m_frogPos
+        >> m_goalWord >> m_inputBuffer >> m_isGoalLocked >> m_isCroaking >> count >> current >> locked;
+    if (in.status() != QDataStream::Ok || count < 0 || m_currentRow < -1 || m_currentRow > 2) return false;
+    if (settings.difficulty < 1) return false;
+
+    m_leaves.clear();
+    m_leaves.reserve(count);
+    QVector<LeafHandle> handles;
+    handles.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        LotusLeaf leaf(0, 0.0, 0.0, QString());
+        in >> leaf.id >> leaf.row >> leaf.x >> leaf.speed >> leaf.word;
+        if (in.status() != QDataStream::Ok || leaf.row < 0 || leaf.row > 2) return false;
+        handles.append(m_leaves.add(leaf));
+    }
+    m_currentLeaf = current >= 0 && current < count ? handles[current] : LeafHandle();
+    m_lockedLeaf = locked >= 0 && locked < count ? handles[locked] : LeafHandle();
+
+    if (settings.dictionaryFile != m_settings.dictionaryFile) loadDictionary(settings.dictionaryFile);
+    m_settings = settings;
+
+    // 与 pauseGame 一致：物理停住，呱呱叫的动画照常
+    m_state = GameState::Paused;
+    m_physicsTimer->stop();
+    m_animTimer->start();
+    AudioMixer::instance().stopMusic();
+    return true;
+}
+
+void FrogGame::onAnimTick() {
+    m_isCroaking = !m_isCroaking;
+}
+
+void FrogGame::spawnLeaves() {
+    double baseSpeed = 0.5 + (m_settings.difficulty - 1) * 0.4;
+    double speeds[] = { baseSpeed, -baseSpeed * 1.3, baseSpeed * 1.6 };
+    double minGap = 260.0;
+    for (int r = 0; r < 3; ++r) {
+        double rightMost = -9999; double leftMost = 9999; bool hasLeaf = false;
+        for (const LotusLeaf& leaf : m_leaves) {
+            if (leaf.row == r) {
+                if (leaf.x > rightMost) rightMost = leaf.x;
+                if (leaf.x < leftMost) leftMost = leaf.x;
+                hasLeaf = true;
+            }
+        }
+        bool needSpawn = false; double spawnX = 0;
+        if (speeds[r] > 0) {
+            if (!hasLeaf || leftMost > (minGap - 100)) { spawnX = -100; needSpawn = true; }
+        }
+        else {
+            if (!hasLeaf || rightMost < (SCREEN_WIDTH - minGap + 100)) { spawnX = SCREEN_WIDTH + 100; needSpawn = true; }
+        }
+        if (needSpawn) {
+            if (m_rng.bounded(100) < 15) {
+                QString w = pickWord();
+                addLeaf(r, spawnX, speeds[r], w);
+            }
+        }
+    }
+}
+
+void FrogGame::onGameTick() {
+    TRACE_SCOPE("FrogGame::onGameTick");
+    spawnLeaves();
+    for (int i = 0; i < m_leaves.size(); ++i) {
+        LotusLeaf& leaf = m_leaves[i];
+        leaf.x += scaledSpeed(leaf.speed);
+
+        if (leaf.x < -200 || leaf.x > SCREEN_WIDTH + 200) {
+            LeafHandle handle = m_leaves.handleAt(i);
+            // 先标记移除，撤退时就不会再选中这片荷叶
+            m_leaves.killAt(i);
+
+            if (m_currentLeaf == handle) {
+                // 青蛙在上面 -> 触发撤退
+                AudioMixer::instance().play(m_splashSound); 
+                retreatFrog(); // 回到上一步
+            }
+
+            // 如果锁定的荷叶出去了，解锁
+            if (m_lockedLeaf == handle) {
+                m_lockedLeaf = LeafHandle();
+                m_inputBuffer.clear();
+            }
+        }
+    }
+    m_leaves.compact();
+
+    if (const LotusLeaf* current = m_leaves.get(m_currentLeaf)) {
+        m_frogPos.setX(current->x);
+        m_frogPos.setY(ROW_Y[current->row]);
+    }
+}
+
+void FrogGame::handleKeyPress(QKeyEvent* event) {
+    if (m_state != GameState::Playing) return;
+    if (event->key() == Qt::Key_Backspace) {
+        if (!m_inputBuffer.isEmpty()) m_inputBuffer.chop(1);
+        return;
+    }
+
+    QString text = event->text(); 
+    if (text.isEmpty() || text.length() > 1) return;
+
+
+    checkInput(text);
+}
+
+void FrogGame::resetFrog() {
+    m_currentRow = -1;
+    m_currentLeaf = LeafHandle();
+    m_inputBuffer.clear();
+
+    m_lockedLeaf = LeafHandle();
+    m_isGoalLocked = false;
+
+    m_frogPos = QPointF(SCREEN_WIDTH / 2, START_BANK_Y);
+    m_goalWord = pickWord();
+}
+
+void FrogGame::pauseGame() {
+    if (m_state == GameState::Playing) {
+        m_state = GameState::Paused;
+        pauseSession();
+        m_physicsTimer->stop();
+        AudioMixer::instance().stopMusic();
+    }
+    else if (m_state == GameState::Paused) {
+        m_state = GameState::Playing;
+        resumeSession();
+        m_physicsTimer->start();
+        AudioMixer::instance().playMusic(":/snd/frog_bg.wav");
+    }
+}
+
+
+void FrogGame::checkInput(const QString& key) {
+    int targetRow = m_currentRow + 1;
+
+    if (m_isGoalLocked) {
+        int nextIdx = m_inputBuffer.length();
+        bool match = nextIdx < m_goalWord.length() && m_goalWord.at(nextIdx) == key.at(0);
+        reportKeystroke(nextIdx < m_goalWord.length() ? m_goalWord.at(nextIdx) : QChar(), key.at(0));
+        if (match) {
+            m_inputBuffer += key;
+            if (m_inputBuffer == m_goalWord) {
+                AudioMixer::instance().play(m_successSound);
+                m_score += 500;
+                m_successCount++;
+                emit scoreChanged(m_score);
+
+                // 成功了一只，是否全部完成？
+                if (m_successCount >= 5) { // 总共5只
+                    stopGame();
+                    emit gameFinished(m_score, true); // 唯一的结算界面
+                }
+                else {
+                    resetFrog(); // 下一只
+                }
+            }
+        }
+        return;
+    }
+
+    if (const LotusLeaf* locked = m_leaves.get(m_lockedLeaf)) {
+        // ... (原代码保持不变) ...
+        int nextIdx = m_inputBuffer.length();
+        bool match = nextIdx < locked->word.length() && locked->word.at(nextIdx) == key.at(0);
+        reportKeystroke(nextIdx < locked->word.length() ? locked->word.at(nextIdx) : QChar(), key.at(0));
+        if (match) {
+            m_inputBuffer += key;
+            if (m_inputBuffer == locked->word) {
+                // Jump!
+                m_currentRow = locked->row;
+                m_currentLeaf = m_lockedLeaf;
+                m_frogPos.setX(locked->x);
+                m_frogPos.setY(ROW_Y[locked->row]);
+
+                m_score += locked->word.length() * 10;
+                AudioMixer::instance().play(m_jumpSound);
+                emit scoreChanged(m_score);
+
+                m_inputBuffer.clear();
+                m_lockedLeaf = LeafHandle();
+            }
+        }
+        return;
+    }
+
+    // 2. 未锁定状态 - 寻找目标
+
+    // Case A: 终点 (Row 3)
+    if (targetRow == 3) {
+        // 还没锁定目标时，只有命中某个单词的首字母才有“应按的字符”
+        reportKeystroke(m_goalWord.startsWith(key) ? key.at(0) : QChar(), key.at(0));
+        if (m_goalWord.startsWith(key)) {
+            m_isGoalLocked = true;
+            m_inputBuffer += key;
+            if (m_inputBuffer == m_goalWord) {
+                // Instant win logic...
+                AudioMixer::instance().play(m_successSound);
+                m_score += 500;
+                m_successCount++;
+                emit scoreChanged(m_score);
+                if (m_successCount >= 5) { stopGame(); emit gameFinished(m_score, true); }
+                else resetFrog();
+            }
+        }
+        return;
+    }
+
+    // Case B: 下一排荷叶
+    // 多片荷叶都匹配时取 id 最大的，实现“优先绑定后生成的单词”
+    int matchIndex = -1;
+    for (int i = 0; i < m_leaves.size(); ++i) {
+        const LotusLeaf& leaf = m_leaves[i];
+
+        if (leaf.row == targetRow && leaf.x > 50 && leaf.x < SCREEN_WIDTH - 50) {
+            if (leaf.word.startsWith(key) && (matchIndex < 0 || leaf.id > m_leaves[matchIndex].id)) {
+                matchIndex = i;
+            }
+        }
+    }
+    reportKeystroke(matchIndex >= 0 ? key.at(0) : QChar(), key.at(0));
+    if (matchIndex < 0) return;
+
+    const LotusLeaf& leaf = m_leaves[matchIndex];
+    m_lockedLeaf = m_leaves.handleAt(matchIndex); // 锁定
+    m_inputBuffer += key;
+    if (m_inputBuffer == leaf.word) {
+        // Instant jump logic...
+        m_currentRow = leaf.row;
+        m_currentLeaf = m_lockedLeaf;
+        m_frogPos.setX(leaf.x);
+        m_frogPos.setY(ROW_Y[leaf.row]);
+        m_score += 10;
+        AudioMixer::instance().play(m_jumpSound);
+        emit scoreChanged(m_score);
+        m_inputBuffer.clear();
+        m_lockedLeaf = LeafHandle();
+    }
+}
+
+void FrogGame::draw(QPainter& painter) {
+    TRACE_SCOPE("FrogGame::draw");
+    painter.setRenderHint(QPainter::Antialiasing);
+    AssetCache& assets = AssetCache::instance();
+
+    if (!m_bgPixmap.isNull()) {
+        painter.drawPixmap(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, assets.scaled(m_bgPixmap, QSize(SCREEN_WIDTH, SCREEN_HEIGHT)));
+    }
+    else {
+        painter.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, QColor(65, 105, 225));
+    }
+
+    // 绘制终点单词
+    painter.setFont(QFont("Arial", 20, QFont::Bold));
+
+    // 判定是否绘制高亮
+    bool isGoalActive = (m_currentRow == 2) && (m_isGoalLocked || (m_inputBuffer.isEmpty() && m_lockedLeaf.isNull()));
+
+    if (isGoalActive && !m_inputBuffer.isEmpty() && m_isGoalLocked) {
+        // 终点被锁定且正在输入
+        int w = painter.fontMetrics().horizontalAdvance(m_goalWord);
+        int startX = (SCREEN_WIDTH - w) / 2;
+        int textY = GOAL_BANK_Y + 10;
+
+        // 已输入：深蓝
+        painter.setPen(Qt::darkBlue);
+        painter.drawText(startX, textY, m_inputBuffer);
+
+        // 未输入：红
+        int typedW = painter.fontMetrics().horizontalAdvance(m_inputBuffer);
+        painter.setPen(Qt::red);
+        painter.drawText(startX + typedW, textY, m_goalWord.mid(m_inputBuffer.length()));
+    }
+    else {
+        // 普通显示 (白色)
+        painter.setPen(Qt::white);
+        painter.drawText(QRect(0, GOAL_BANK_Y - 20, SCREEN_WIDTH, 40), Qt::AlignCenter, m_goalWord);
+    }
+
+    // 绘制荷叶（合批提交）
+    SpriteBatch leafBatch(assets.scaled(m_leafPixmap));
+    for (const LotusLeaf& leaf : m_leaves) {
+        leafBatch.addCentered(QPointF(leaf.x, ROW_Y[leaf.row]));
+    }
+    leafBatch.flush(painter);
+
+    // 字体改小
+    painter.setFont(QFont("Arial", 12, QFont::Bold));
+    for (int i = 0; i < m_leaves.size(); ++i) {
+        const LotusLeaf& leaf = m_leaves[i];
+        int textY = ROW_Y[leaf.row] + 5;
+
+        // 判定该荷叶是否被锁定高亮
+        // 条件：它是锁定的荷叶，或者 输入为空且符合行号要求
+        bool isTarget = (m_leaves.handleAt(i) == m_lockedLeaf);
+
+        if (isTarget) {
+            QFontMetrics fm(painter.font());
+            int totalW = fm.horizontalAdvance(leaf.word);
+            int startX = leaf.x - totalW / 2;
+
+            // 已输入：深蓝
+            painter.setPen(Qt::darkBlue);
+            painter.drawText(startX, textY, m_inputBuffer);
+
+            // 未输入：红
+            int typedW = fm.horizontalAdvance(m_inputBuffer);
+            painter.setPen(Qt::red);
+            painter.drawText(startX + typedW, textY, leaf.word.mid(m_inputBuffer.length()));
+        }
+        else {
+            // 普通：黑色
+            painter.setPen(Qt::black);
+            // 扩大文本框宽度
+            QRect textRect(leaf.x - 70, ROW_Y[leaf.row] - 20, 140, 40);
+            painter.drawText(textRect, Qt::AlignCenter, leaf.word);
+        }
+    }
+
+    // 绘制青蛙
+    QPixmap* currentFrogPix = m_isCroaking ? &m_frogBack2 : &m_frogBack1;
+    if (currentFrogPix && !currentFrogPix->isNull()) {
+        painter.drawPixmap(m_frogPos.x() - currentFrogPix->width() / 2,
+            m_frogPos.y() - currentFrogPix->height() / 2,
+            assets.scaled(*currentFrogPix));
+    }
+
+    // 绘制剩余青蛙（岸边等待）
+    // 注意：m_frogsRemaining 包含当前正在跳的这一只。
+    // 所以岸边等待的数量是 m_frogsRemaining - 1
+    int waitingFrogs = 5 - m_successCount - 1;
+    if (waitingFrogs < 0) waitingFrogs = 0; // 保护一下
+
+    for (int i = 0; i < waitingFrogs; ++i) {
+        int fx = SCREEN_WIDTH - 40 - (i * 35);
+        int fy = SCREEN_HEIGHT - 40;
+        if (currentFrogPix && !currentFrogPix->isNull())
+            painter.drawPixmap(fx, fy, 25, 25, assets.scaled(*currentFrogPix, QSize(25, 25)));
+    }
+
+    // 绘制对岸青蛙
+    QPixmap* goalFrogPix = m_isCroaking ? &m_frogFront2 : &m_frogFront1;
+    int startGoalX = 50;
+    int gapGoal = 50;
+    for (int i = 0; i < m_successCount; ++i) {
+        int gx = startGoalX + i * gapGoal;
+        if (goalFrogPix && !goalFrogPix->isNull()) {
+            painter.drawPixmap(gx, 40, 40, 40, assets.scaled(*goalFrogPix, QSize(40, 40)));
+        }
+    }
+
+    painter.setPen(Qt::white);
+    painter.setFont(QFont("Microsoft YaHei", 14, QFont::Bold));
+    painter.drawText(20, 40, QString("Score: %1").arg(m_score));
 }
\ No newline at end of file
@@ -1,88 +1,107 @@
-﻿#ifndef FROGGAME_H
-#define FROGGAME_H
-
-#include "gamebase.h"
-#include "froggamesettings.h"
-#include <QPixmap>
-#include <QList>
-#include <QPointF>
-#include <QtMultimedia/QSoundEffect>
-
-struct LotusLeaf {
-    int id;
-    int row;
-    double x;
-    double speed;
-    QString word;
-
-    LotusLeaf(int r, double startX, double s, QString w)
-        : row(r), x(startX), speed(s), word(w) {
-    }
-};
-
-class FrogGame : public GameBase {
-    Q_OBJECT
-public:
-    explicit FrogGame(QObject* parent = nullptr);
-    ~FrogGame();
-
-    void initGame() override;
-    void startGame() override;
-    void pauseGame() override;
-    void stopGame() override;
-    void draw(QPainter& painter) override;
-    void handleKeyPress(QKeyEvent* event) override;
-    void updateSettings(const FrogSettingsData& settings);
-
-private slots:
-    void onGameTick();
-    void onAnimTick();
-
-private:
-    void spawnLeaves();
-    void resetFrog();           // 重置青蛙位置（准备下一只）
-    void retreatFrog();
-    void checkInput(const QString& key); // 接收字符进行判定
-    void loadDictionary(const QString& filename);
-
-    // --- 资源 ---
-    QPixmap m_bgPixmap;
-    QPixmap m_leafPixmap;
-
-    QPixmap m_frogBack1;
-    QPixmap m_frogBack2;
-    QPixmap m_frogFront1;
-    QPixmap m_frogFront2;
-
-    // --- 音效 ---
-    QSoundEffect* m_jumpSound;
-    QSoundEffect* m_bgMusic;
-    QSoundEffect* m_splashSound;
-    QSoundEffect* m_successSound;
-
-    // --- 游戏数据 ---
-    QList<LotusLeaf*> m_leaves;
-    QStringList m_wordList;
-
-    int m_frogsRemaining; // 剩余待出场的青蛙总数 (初始5)
-    int m_successCount;   // 成功到达对岸的数量
-
-    int m_currentRow;
-    LotusLeaf* m_currentLeaf;
-    QPointF m_frogPos;
-
-    QString m_goalWord;
-    QString m_inputBuffer;
-
-    // 输入锁定机制
-    LotusLeaf* m_lockedLeaf; // 当前锁定的荷叶
-    bool m_isGoalLocked;     // 当前是否锁定了终点单词
-
-    QTimer* m_physicsTimer;
-    QTimer* m_animTimer;
-    bool m_isCroaking;
-
-    FrogSettingsData m_settings;
-};
-
+﻿#ifndef FROGGAME_H
+#define FROGGAME_H
+
+#include "gamecore_global.h"
+#include "gamebase.h"
+#include "froggamesettings.h"
+#include "entitypool.h"
+#include "contentgenerator.h"
+#include <QPixmap>
+#include <QPointF>
+
+struct LotusLeaf {
+    int id;       // 生成序号，越大越新（容器删除时会打乱顺序，不能再按位置判断新旧）
+    int row;
+    double x;
+    double speed;
+    QString word;
+
+    LotusLeaf(int r, double startX, double s, QString w)
+        : id(0), row(r), x(startX), speed(s), word(w) {
+    }
+};
+
+typedef EntityPool<LotusLeaf>::Handle LeafHandle;
+
+class GAMECORE_EXPORT FrogGame : public GameBase {
+    Q_OBJECT
+public:
+    explicit FrogGame(QObject* parent = nullptr);
+    ~FrogGame();
+
+    void initGame() override;
+    void startGame() override;
+    void pauseGame() override;
+    void stopGame() override;
+    void draw(QPainter& painter) override;
+    void handleKeyPress(QKeyEvent* event) override;
+    QString gameId() const override { return QStringLiteral("frog"); }
+    int difficulty() const override { return m_settings.difficulty; }
+    const GameCapabilities& capabilities() const override;
+    SettingsResult execSettings(QWidget* parent) override;
+    void applySettings() override { updateSettings(m_pendingSettings); }
+    void updateSettings(const FrogSettingsData& settings);
+
+protected:
+    void saveState(QDataStream& out) const override;
+    bool restoreState(QDataStream& in) override;
+
+private slots:
+    void onGameTick();
+    void onAnimTick();
+
+private:
+    friend class BenchAccess; // 基准测试直接构造内部状态
+
+    void spawnLeaves();
+    void resetFrog();           // 重置青蛙位置（准备下一只）
+    void retreatFrog();
+    void checkInput(const QString& key); // 接收字符进行判定
+    void loadDictionary(const QString& filename);
+    LeafHandle addLeaf(int row, double x, double speed, const QString& word);
+    QString pickWord(); // 按难度倍率偏向长词或短词
+
+    // --- 资源 ---
+    QPixmap m_bgPixmap;
+    QPixmap m_leafPixmap;
+
+    QPixmap m_frogBack1;
+    QPixmap m_frogBack2;
+    QPixmap m_frogFront1;
+    QPixmap m_frogFront2;
+
+    // --- 音效 ---
+    int m_jumpSound;    // AudioMixer 音效 id
+    int m_splashSound;
+    int m_successSound;
+
+    // --- 游戏数据 ---
+    EntityPool<LotusLeaf> m_leaves;
+    int m_nextLeafId;
+    QStringList m_wordList;
+    ContentGenerator::WordSampler m_wordSampler; // 偏向玩家的薄弱键
+
+    int m_frogsRemaining; // 剩余待出场的青蛙总数 (初始5)
+    int m_successCount;   // 成功到达对岸的数量
+
+    int m_currentRow;
+    LeafHandle m_currentLeaf; // 荷叶被移除后句柄自动失效
+    QPointF m_frogPos;
+
+    QString m_goalWord;
+    QString m_inputBuffer;
+
+    // 输入锁定机制
+    LeafHandle m_lockedLeaf; // 当前锁定的荷叶
+    bool m_isGoalLocked;     // 当前是否锁定了终点单词
+
+    QTimer* m_physicsTimer;
+    QTimer* m_animTimer;
+    bool m_isCroaking;
+
+    FrogSettingsData m_settings;
+    FrogGameSettings* m_settingsDialog = nullptr; // 第一次打开设置时创建
+    FrogSettingsData m_pendingSettings;
+};
+
 #endif // FROGGAME_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+﻿#include "gamebase.h"
+
+// 任何一个游戏的快照字段有增减都要加一；旧版本的快照直接丢弃
+const quint16 SNAPSHOT_VERSION = 3;
+
+QByteArray GameBase::saveSnapshot() const {
+    QByteArray snapshot;
+    QDataStream out(&snapshot, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+
+    out << SNAPSHOT_VERSION << gameId() << m_rng << qint32(m_score)
+        << qint32(m_keystrokes) << qint32(m_correctKeystrokes) << qint64(sessionDurationMs())
+        << m_difficultyParams.spawnRate << m_difficultyParams.speed << m_difficultyParams.wordLength;
+    saveState(out);
+    return snapshot;
+}
+
+bool GameBase::restoreSnapshot(const QByteArray& snapshot) {
+    QDataStream in(snapshot);
+    in.setVersion(QDataStream::Qt_5_0);
+
+    quint16 version;
+    QString id;
+    GameRandom rng;
+    qint32 score, keystrokes, correct;
+    qint64 sessionMs;
+    DifficultyParams params;
+    in >> version;
+    if (in.status() != QDataStream::Ok || version != SNAPSHOT_VERSION) return false;
+    in >> id;
+    if (in.status() != QDataStream::Ok || id != gameId()) return false;
+    in >> rng >> score >> keystrokes >> correct >> sessionMs
+        >> params.spawnRate >> params.speed >> params.wordLength;
+    if (in.status() != QDataStream::Ok) return false;
+
+    // 先把游戏复位，读到一半失败时不会留下新旧混杂的状态
+    initGame();
+    if (!restoreState(in) || in.status() != QDataStream::Ok) {
+        initGame();
+        return false;
+    }
+
+    m_rng = rng;
+    m_score = score;
+    m_keystrokes = keystrokes;
+    m_correctKeystrokes = correct;
+    m_sessionClock.invalidate(); // 恢复后是暂停状态，继续时才开始计时
+    m_sessionOffsetMs = sessionMs;
+    m_difficultyParams = params;
+    emit scoreChanged(m_score);
+    return true;
+}
+
+QString GameBase::snapshotGameId(const QByteArray& snapshot) {
+    QDataStream in(snapshot);
+    in.setVersion(QDataStream::Qt_5_0);
+    quint16 version;
+    QString id;
+    in >> version >> id;
+    if (in.status() != QDataStream::Ok || version != SNAPSHOT_VERSION) return QString();
+    return id;
+}
\ No newline at end of file
@@ -1,43 +1,165 @@
-﻿#ifndef GAMEBASE_H
-#define GAMEBASE_H
-
-#include <QObject>
-#include <QPainter>
-#include <QKeyEvent>
-#include <QTimer>
-
-// 定义游戏状态
-enum class GameState {
-    Ready,
-    Playing,
-    Paused,
-    GameOver,
-    Victory
-};
-
-class GameBase : public QObject {
-    Q_OBJECT
-public:
-    explicit GameBase(QObject *parent = nullptr) : QObject(parent), m_state(GameState::Ready) {}
-    virtual ~GameBase() {}
-
-    virtual void initGame() = 0;              // 初始化/重置游戏
-    virtual void startGame() = 0;             // 开始
-    virtual void pauseGame() = 0;             // 暂停/继续
-    virtual void stopGame() = 0;              // 结束
-    virtual void draw(QPainter &painter) = 0; // 绘制游戏画面
-    virtual void handleKeyPress(QKeyEvent *event) = 0; // 处理按键
-
-    // 通用状态获取
-    GameState getState() const { return m_state; }
-
-protected:
-    GameState m_state;
-    int m_score = 0;
-
-signals:
-    void gameFinished(int score, bool win); // 游戏结束信号
-    void scoreChanged(int newScore);        // 分数变化信号
-};
-
+﻿#ifndef GAMEBASE_H
+#define GAMEBASE_H
+
+#include "gamecore_global.h"
+#include <QObject>
+#include <QByteArray>
+#include <QDataStream>
+#include <QPainter>
+#include <QKeyEvent>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include "gamerandom.h"
+#include "typinganalytics.h"
+#include "gamecapabilities.h"
+
+class QWidget;
+
+// 逻辑画面尺寸：所有游戏都在这个坐标系中绘制，由 GameWidget 缩放到实际窗口
+const int SCREEN_WIDTH = 800;
+const int SCREEN_HEIGHT = 600;
+
+// 难度倍率：由 DifficultyController 按玩家实时水平调节，1.0 为游戏自身设置的难度。
+// 各游戏只在对应的位置乘上倍率，不需要各自的难度表
+struct DifficultyParams {
+    double spawnRate = 1.0;   // 出怪/出字频率（生成间隔除以它）
+    double speed = 1.0;       // 下落、移动速度；停留时间除以它
+    double wordLength = 1.0;  // 单词长度（青蛙过河）
+
+    bool operator==(const DifficultyParams& o) const {
+        return spawnRate == o.spawnRate && speed == o.speed && wordLength == o.wordLength;
+    }
+    bool operator!=(const DifficultyParams& o) const { return !(*this == o); }
+};
+
+// 定义游戏状态
+enum class GameState {
+    Ready,
+    Playing,
+    Paused,
+    GameOver,
+    Victory
+};
+
+class GAMECORE_EXPORT GameBase : public QObject {
+    Q_OBJECT
+public:
+    explicit GameBase(QObject *parent = nullptr)
+        : QObject(parent), m_state(GameState::Ready), m_rng(QRandomGenerator::global()->generate()) {}
+    virtual ~GameBase() {}
+
+    virtual void initGame() = 0;              // 初始化/重置游戏
+    virtual void startGame() = 0;             // 开始
+    virtual void pauseGame() = 0;             // 暂停/继续
+    virtual void stopGame() = 0;              // 结束
+    virtual void draw(QPainter &painter) = 0; // 绘制游戏画面
+    virtual void handleKeyPress(QKeyEvent *event) = 0; // 处理按键
+
+    // 通用状态获取
+    GameState getState() const { return m_state; }
+
+    // 固定随机种子，使出怪/出字序列可复现（基准测试、回放）
+    void seedRandom(quint32 seed) { m_rng.seed(seed); }
+
+    // 统计用：游戏标识（成绩、统计按它分类）和当前难度
+    virtual QString gameId() const = 0;
+    virtual int difficulty() const { return 1; }
+
+    // 能力描述（结算皮肤、HUD 布局等），GameWidget 每次切换到该游戏时读取一次。
+    // 默认：通用 HUD、没有设置按钮、鼠的故事的结算皮肤
+    virtual const GameCapabilities& capabilities() const {
+        static const GameCapabilities caps = defaultCapabilities();
+        return caps;
+    }
+
+    // 设置：弹出本游戏自己的设置对话框。返回 SettingsChanged 时新设置先暂存，
+    // 由 GameWidget 询问是否重开之后调用 applySettings() 生效
+    enum SettingsResult { SettingsRejected, SettingsUnchanged, SettingsChanged };
+    virtual SettingsResult execSettings(QWidget* parent) { Q_UNUSED(parent); return SettingsRejected; }
+    virtual void applySettings() {}
+
+    // 结算界面选“下一关”时调用，之后重新开局
+    virtual void nextLevel() {}
+    // 结算界面显示的角色（生死时速 0:警察 1:小偷）
+    virtual int resultRole() const { return 0; }
+
+    // 快照：进行中的一局的完整状态（实体、随机数、计时、输入缓冲、分数），
+    // 紧凑的二进制，开头是版本和 gameId。保存不影响游戏继续运行；
+    // 恢复后游戏处于暂停状态，由 pauseGame()（或游戏自己的继续操作）接着玩
+    QByteArray saveSnapshot() const;
+    bool restoreSnapshot(const QByteArray& snapshot); // 版本或游戏不符、数据损坏时返回 false
+    static QString snapshotGameId(const QByteArray& snapshot);
+    // 当前是否有一局可以挂起：游戏支持快照，并且正在进行或暂停
+    virtual bool canSuspend() const {
+        return capabilities().supportsSnapshots && (m_state == GameState::Playing || m_state == GameState::Paused);
+    }
+
+    // 本局统计，gameFinished 发出时由 GameStats 读取；时长只算实际在玩的时间，不含暂停
+    qint64 sessionDurationMs() const { return m_sessionOffsetMs + (m_sessionClock.isValid() ? m_sessionClock.elapsed() : 0); }
+    int sessionKeystrokes() const { return m_keystrokes; }
+    int sessionCorrectKeystrokes() const { return m_correctKeystrokes; }
+
+    // 难度倍率，随时可改，下一次生成/下一帧生效
+    const DifficultyParams& difficultyParams() const { return m_difficultyParams; }
+    void setDifficultyParams(const DifficultyParams& params) { m_difficultyParams = params; }
+
+protected:
+    // 各游戏写入/读出自己的那部分状态，两边字段顺序一致。
+    // restoreState 要停掉定时器并进入暂停状态；不支持快照的游戏返回 false
+    virtual void saveState(QDataStream& out) const { Q_UNUSED(out); }
+    virtual bool restoreState(QDataStream& in) { Q_UNUSED(in); return false; }
+
+    static GameCapabilities defaultCapabilities() {
+        GameCapabilities caps;
+        caps.hud.settings.visible = false;
+        return caps;
+    }
+
+    // 开局时调用：清零按键计数并开始计时
+    void beginSession() {
+        m_sessionClock.start();
+        m_sessionOffsetMs = 0;
+        m_keystrokes = 0;
+        m_correctKeystrokes = 0;
+    }
+    // 暂停/继续时调用：暂停期间本局计时停住
+    void pauseSession() {
+        if (!m_sessionClock.isValid()) return;
+        m_sessionOffsetMs += m_sessionClock.elapsed();
+        m_sessionClock.invalidate();
+    }
+    void resumeSession() {
+        if (!m_sessionClock.isValid()) m_sessionClock.start();
+    }
+    // 每次输入调用一次：expected 是应该按的字符（当时没有目标传 QChar()），actual 是实际输入。
+    // 更新本局计数并交给 TypingAnalytics（只写无锁缓冲区）；要在 emit gameFinished 之前调用
+    void reportKeystroke(QChar expected, QChar actual) {
+        ++m_keystrokes;
+        if (!expected.isNull() && expected == actual) ++m_correctKeystrokes;
+        TypingAnalytics::instance().record(expected, actual);
+    }
+
+    // 按难度倍率换算：生成间隔（帧或毫秒）、速度、停留时间
+    int scaledInterval(int interval) const { return qMax(1, qRound(interval / m_difficultyParams.spawnRate)); }
+    double scaledSpeed(double speed) const { return speed * m_difficultyParams.speed; }
+    int scaledDuration(int ms) const { return qMax(1, qRound(ms / m_difficultyParams.speed)); }
+
+    GameState m_state;
+    int m_score = 0;
+    GameRandom m_rng; // 每个游戏独立的随机数源，状态随快照保存
+    DifficultyParams m_difficultyParams;
+
+private:
+    QElapsedTimer m_sessionClock;
+    qint64 m_sessionOffsetMs = 0; // 之前各段（暂停前、快照恢复前）累计玩过的时长
+    int m_keystrokes = 0;
+    int m_correctKeystrokes = 0;
+
+signals:
+    void gameFinished(int score, bool win); // 游戏结束信号
+    void scoreChanged(int newScore);        // 分数变化信号
+    void requestReturnToMenu();             // 游戏自己的界面要求回主菜单
+};
+
 #endif // GAMEBASE_H
\ No newline at end of file
@@ -0,0 +1,62 @@
+﻿#ifndef GAMECAPABILITIES_H
+#define GAMECAPABILITIES_H
+
+#include <QPoint>
+#include <QString>
+
+// HUD 上的一个按钮：是否显示、逻辑坐标和三态贴图
+struct HudButton {
+    bool visible = false;
+    QPoint pos;
+    QString normal;
+    QString hover;
+    QString pressed;
+
+    // 通用贴图 :/img/public_<name>.bmp / _on / _clicked
+    static HudButton publicButton(const QString& name, const QPoint& pos) {
+        return make(pos, ":/img/public_" + name + ".bmp", ":/img/public_" + name + "_on.bmp",
+            ":/img/public_" + name + "_clicked.bmp");
+    }
+
+    static HudButton make(const QPoint& pos, const QString& normal, const QString& hover, const QString& pressed) {
+        HudButton b;
+        b.visible = true;
+        b.pos = pos;
+        b.normal = normal;
+        b.hover = hover;
+        b.pressed = pressed;
+        return b;
+    }
+};
+
+// GameWidget 的五个 HUD 按钮：开始、暂停、结束、设置、退出
+struct HudLayout {
+    HudButton start;
+    HudButton pause;
+    HudButton end;
+    HudButton settings;
+    HudButton quit;
+
+    // 通用贴图，摆在左下角的控制面板上
+    static HudLayout standard() {
+        HudLayout l;
+        l.start = HudButton::publicButton("start", QPoint(160, 480));
+        l.pause = HudButton::publicButton("pause", QPoint(120, 510));
+        l.end = HudButton::publicButton("end", QPoint(200, 530));
+        l.settings = HudButton::publicButton("settings", QPoint(150, 550));
+        l.quit = HudButton::publicButton("exit", QPoint(20, 550));
+        return l;
+    }
+};
+
+// 游戏的能力描述：GameWidget 切换游戏时读取一次，据此摆 HUD、弹结算界面和设置，
+// 不再按具体游戏类型分支。每个游戏返回自己的静态实例
+struct GameCapabilities {
+    QString resultTheme = QStringLiteral("mole"); // 结算界面皮肤：mole / apple / frog / police；为空表示游戏自带结算画面
+    HudLayout hud = HudLayout::standard();
+    bool settingsBeforeStart = false;       // 选中游戏时先弹设置，取消则留在主菜单（生死时速选角色和文章）
+    bool keepSettingsWithoutRestart = true; // 改了设置但不重开时，新设置仍然生效（下一局起）
+    bool supportsSnapshots = false;         // 实现了 saveState/restoreState，回主菜单或退出时可以挂起这一局
+};
+
+#endif // GAMECAPABILITIES_H
\ No newline at end of file
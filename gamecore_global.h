@@ -0,0 +1,14 @@
+﻿#ifndef GAMECORE_GLOBAL_H
+#define GAMECORE_GLOBAL_H
+
+#include <QtGlobal>
+
+// 游戏核心（GameBase、各服务单例、内置游戏）编成共享库，主程序、基准测试和游戏插件都链接它，
+// 进程里的 staticMetaObject 和单例因此只有一份
+#if defined(GAMECORE_LIBRARY)
+#  define GAMECORE_EXPORT Q_DECL_EXPORT
+#else
+#  define GAMECORE_EXPORT Q_DECL_IMPORT
+#endif
+
+#endif // GAMECORE_GLOBAL_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+﻿#include "gameglview.h"
+#include <QSurfaceFormat>
+
+GameGLView::GameGLView(const RenderFunc& render, QWidget* parent)
+    : QOpenGLWidget(parent), m_render(render) {
+    // 垂直同步：帧率跟随显示器刷新
+    QSurfaceFormat fmt = format();
+    fmt.setSwapInterval(1);
+    setFormat(fmt);
+
+    setFocusPolicy(Qt::NoFocus);
+    setAttribute(Qt::WA_TransparentForMouseEvents);
+}
+
+void GameGLView::paintGL() {
+    QPainter painter(this);
+    m_render(painter);
+}
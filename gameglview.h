@@ -0,0 +1,27 @@
+﻿#ifndef GAMEGLVIEW_H
+#define GAMEGLVIEW_H
+
+#include "gamecore_global.h"
+#include <QOpenGLWidget>
+#include <QPainter>
+#include <functional>
+
+// OpenGL 渲染视图：铺满 GameWidget，用 QPainter 的 OpenGL 引擎执行同一套 draw()。
+// 贴图会被缓存为纹理，背景/半透明叠加/精灵合成都交给 GPU。
+// 只负责画面，键盘和鼠标事件仍由 GameWidget 及其按钮处理。
+class GAMECORE_EXPORT GameGLView : public QOpenGLWidget {
+    Q_OBJECT
+
+public:
+    typedef std::function<void(QPainter&)> RenderFunc;
+
+    explicit GameGLView(const RenderFunc& render, QWidget* parent = nullptr);
+
+protected:
+    void paintGL() override;
+
+private:
+    RenderFunc m_render;
+};
+
+#endif // GAMEGLVIEW_H
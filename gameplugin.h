@@ -0,0 +1,30 @@
+﻿#ifndef GAMEPLUGIN_H
+#define GAMEPLUGIN_H
+
+#include <QString>
+#include <QtPlugin>
+
+class GameBase;
+class QObject;
+
+// 游戏的基本信息：主菜单上怎么显示。
+// 结算皮肤、HUD 布局等由游戏对象自己的 GameBase::capabilities() 提供
+struct GameInfo {
+    QString id;           // 与 GameBase::gameId() 一致
+    QString name;         // 菜单按钮上的名字
+    int order = 100;      // 菜单顺序，小的在前
+};
+
+// 以共享库形式发布的游戏实现这个接口，并用 Q_PLUGIN_METADATA 附带 JSON：
+//   { "id": "typist", "name": "...", "order": 60 }
+// 启动时只读取 JSON 生成菜单项，玩家选中时才加载库、创建游戏。
+class GamePluginInterface {
+public:
+    virtual ~GamePluginInterface() {}
+    virtual GameBase* createGame(QObject* parent) = 0;
+};
+
+#define GamePluginInterface_iid "org.typinggames.GamePluginInterface/1.0"
+Q_DECLARE_INTERFACE(GamePluginInterface, GamePluginInterface_iid)
+
+#endif // GAMEPLUGIN_H
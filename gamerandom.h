@@ -0,0 +1,64 @@
+﻿#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <QDataStream>
+#include <QtGlobal>
+#include <random>
+#include <sstream>
+
+// 游戏用的随机数源，接口与用到的那部分 QRandomGenerator 一致，同一个种子给出相同的序列。
+// QRandomGenerator 的内部状态无法导出，这里直接用 std::mt19937，
+// 快照里存引擎的完整状态（624 个字），恢复时原样读回，耗时与已取过多少个数无关
+class GameRandom {
+public:
+    explicit GameRandom(quint32 seed = 1) { this->seed(seed); }
+
+    void seed(quint32 seed) {
+        // 与 QRandomGenerator(seed) 一样用 seed_seq 初始化
+        std::seed_seq sequence{ seed };
+        m_engine.seed(sequence);
+    }
+
+    quint32 generate() { return quint32(m_engine()); }
+    quint64 generate64() {
+        quint64 low = generate();
+        return low | (quint64(generate()) << 32);
+    }
+    double generateDouble() {
+        // 取 53 位，均匀分布在 [0, 1)
+        return double(generate64() >> 11) / double(Q_UINT64_C(1) << 53);
+    }
+
+    // [0, highest)
+    quint32 bounded(quint32 highest) { return quint32((quint64(generate()) * highest) >> 32); }
+    int bounded(int highest) { Q_ASSERT(highest > 0); return int(bounded(quint32(highest))); }
+    // [lowest, highest)
+    int bounded(int lowest, int highest) { return lowest + bounded(highest - lowest); }
+    double bounded(double highest) { return generateDouble() * highest; }
+
+    friend QDataStream& operator<<(QDataStream& out, const GameRandom& rng) {
+        std::ostringstream state;
+        state << rng.m_engine;
+        return out << QByteArray::fromStdString(state.str());
+    }
+    friend QDataStream& operator>>(QDataStream& in, GameRandom& rng) {
+        QByteArray bytes;
+        in >> bytes;
+        if (in.status() != QDataStream::Ok) return in;
+        // 先读进临时引擎，格式不对时 rng 保持原样
+        std::istringstream state(bytes.toStdString());
+        std::mt19937 engine;
+        state >> engine;
+        if (state.fail()) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            return in;
+        }
+        rng.m_engine = engine;
+        return in;
+    }
+
+private:
+    std::mt19937 m_engine;
+};
+
+#endif // GAMERANDOM_H
\ No newline at end of file
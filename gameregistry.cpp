@@ -0,0 +1,122 @@
+﻿#include "gameregistry.h"
+#include "molegame.h"
+#include "policegame.h"
+#include "spacegame.h"
+#include "applegame.h"
+#include "froggame.h"
+#include <QDebug>
+#include <QDir>
+#include <QJsonObject>
+#include <QLibrary>
+#include <QPluginLoader>
+#include <algorithm>
+
+namespace {
+
+GameInfo makeInfo(const QString& id, const QString& name, int order) {
+    GameInfo info;
+    info.id = id;
+    info.name = name;
+    info.order = order;
+    return info;
+}
+
+} // namespace
+
+GameRegistry& GameRegistry::instance() {
+    static GameRegistry instance;
+    return instance;
+}
+
+GameRegistry::GameRegistry() {
+    registerBuiltins();
+}
+
+void GameRegistry::registerBuiltins() {
+    registerGame(makeInfo("mole", QStringLiteral("鼠的故事"), 10),
+        [](QObject* parent) { return new MoleGame(parent); });
+    registerGame(makeInfo("police", QStringLiteral("生死时速"), 20),
+        [](QObject* parent) { return new PoliceGame(parent); });
+    registerGame(makeInfo("space", QStringLiteral("太空大战"), 30),
+        [](QObject* parent) { return new SpaceGame(parent); });
+    registerGame(makeInfo("apple", QStringLiteral("拯救苹果"), 40),
+        [](QObject* parent) { return new AppleGame(parent); });
+    registerGame(makeInfo("frog", QStringLiteral("激流勇进"), 50),
+        [](QObject* parent) { return new FrogGame(parent); });
+}
+
+void GameRegistry::registerGame(const GameInfo& info, const Factory& factory) {
+    Entry entry;
+    entry.info = info;
+    entry.factory = factory;
+
+    auto it = m_index.constFind(info.id);
+    if (it != m_index.constEnd()) {
+        m_entries[*it] = entry;
+    }
+    else {
+        m_index.insert(info.id, m_entries.size());
+        m_entries.append(entry);
+    }
+}
+
+int GameRegistry::discoverPlugins(const QString& dirPath) {
+    QDir dir(dirPath);
+    if (!dir.exists()) return 0;
+
+    int count = 0;
+    for (const QFileInfo& fileInfo : dir.entryInfoList(QDir::Files)) {
+        const QString path = fileInfo.absoluteFilePath();
+        if (!QLibrary::isLibrary(path)) continue;
+
+        // metaData() 只读取库里嵌入的 JSON，不执行库中的代码
+        QPluginLoader loader(path);
+        const QJsonObject meta = loader.metaData();
+        if (meta.value("IID").toString() != QLatin1String(GamePluginInterface_iid)) continue;
+
+        const QJsonObject data = meta.value("MetaData").toObject();
+        GameInfo info = makeInfo(data.value("id").toString(), data.value("name").toString(),
+            data.value("order").toInt(100));
+        if (info.id.isEmpty()) {
+            qWarning() << "Game plugin without id:" << path;
+            continue;
+        }
+        if (info.name.isEmpty()) info.name = info.id;
+
+        registerGame(info, Factory());
+        m_entries[m_index.value(info.id)].pluginPath = path;
+        count++;
+    }
+    return count;
+}
+
+QVector<GameInfo> GameRegistry::games() const {
+    QVector<GameInfo> result;
+    result.reserve(m_entries.size());
+    for (const Entry& entry : m_entries) result.append(entry.info);
+    std::stable_sort(result.begin(), result.end(), [](const GameInfo& a, const GameInfo& b) {
+        return a.order < b.order;
+    });
+    return result;
+}
+
+const GameInfo* GameRegistry::find(const QString& id) const {
+    auto it = m_index.constFind(id);
+    return it == m_index.constEnd() ? nullptr : &m_entries[*it].info;
+}
+
+GameBase* GameRegistry::create(const QString& id, QObject* parent) {
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd()) return nullptr;
+    const Entry& entry = m_entries[*it];
+    if (entry.factory) return entry.factory(parent);
+
+    // 插件：第一次创建时才加载库；库加载后常驻到程序退出
+    QPluginLoader loader(entry.pluginPath);
+    GamePluginInterface* plugin = qobject_cast<GamePluginInterface*>(loader.instance());
+    if (!plugin) {
+        qWarning() << "Cannot load game plugin" << entry.pluginPath << loader.errorString();
+        return nullptr;
+    }
+    return plugin->createGame(parent);
+}
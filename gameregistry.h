@@ -0,0 +1,49 @@
+﻿#ifndef GAMEREGISTRY_H
+#define GAMEREGISTRY_H
+
+#include "gamecore_global.h"
+#include "gameplugin.h"
+#include <QHash>
+#include <QVector>
+#include <functional>
+
+// 游戏注册表
+// 内置的五个游戏在构造时注册工厂函数；discoverPlugins 扫描目录里的插件，
+// 只读元数据不加载库。create 时才真正创建游戏（插件此时才经 QPluginLoader 加载），
+// 没被选中过的游戏不占内存。只在 GUI 线程使用。
+class GAMECORE_EXPORT GameRegistry {
+public:
+    static GameRegistry& instance();
+
+    typedef std::function<GameBase*(QObject*)> Factory;
+
+    // 同一 id 再次注册时覆盖（插件可以替换内置游戏）
+    void registerGame(const GameInfo& info, const Factory& factory);
+
+    // 扫描目录下的共享库，登记 IID 匹配的插件，返回登记的个数
+    int discoverPlugins(const QString& dirPath);
+
+    // 按菜单顺序
+    QVector<GameInfo> games() const;
+    const GameInfo* find(const QString& id) const;
+
+    // 创建游戏；插件加载失败或 id 未登记返回 nullptr
+    GameBase* create(const QString& id, QObject* parent);
+
+private:
+    GameRegistry();
+    GameRegistry(const GameRegistry&) = delete;
+    GameRegistry& operator=(const GameRegistry&) = delete;
+
+    void registerBuiltins();
+
+    struct Entry {
+        GameInfo info;
+        Factory factory;     // 内置游戏
+        QString pluginPath;  // 插件游戏
+    };
+    QVector<Entry> m_entries;
+    QHash<QString, int> m_index; // id -> m_entries 下标
+};
+
+#endif // GAMEREGISTRY_H
@@ -0,0 +1,260 @@
+﻿#include "gamestats.h"
+#include "gamebase.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QRunnable>
+
+const quint32 STATS_MAGIC = 0x54535054; // "TPST"
+const quint16 STATS_VERSION = 1;
+
+// 记录类型
+const quint8 RECORD_RESULT = 1;   // 一局的明细
+const quint8 RECORD_SUMMARY = 2;  // 压缩后合并的累计数据
+
+namespace {
+
+QByteArray encodeResult(const GameRecord& r) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << RECORD_RESULT << r.game << r.player << qint32(r.score) << r.win << r.accuracy << r.wpm
+        << qint64(r.durationMs) << qint32(r.difficulty) << qint64(r.timestamp);
+    return payload;
+}
+
+QByteArray encodeSummary(const QString& game, const QString& player, const PlayerSummary& s) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << RECORD_SUMMARY << game << player << qint32(s.games) << qint32(s.wins) << qint64(s.totalScore)
+        << qint32(s.bestScore) << qint64(s.totalDurationMs) << s.bestWpm << s.accuracySum << qint32(s.accuracyCount);
+    return payload;
+}
+
+} // namespace
+
+void PlayerSummary::add(const GameRecord& r) {
+    games++;
+    if (r.win) wins++;
+    totalScore += r.score;
+    bestScore = qMax(bestScore, r.score);
+    totalDurationMs += r.durationMs;
+    bestWpm = qMax(bestWpm, r.wpm);
+    if (r.accuracy >= 0.0) {
+        accuracySum += r.accuracy;
+        accuracyCount++;
+    }
+}
+
+void PlayerSummary::add(const PlayerSummary& s) {
+    if (s.games > 0) bestScore = games > 0 ? qMax(bestScore, s.bestScore) : s.bestScore;
+    games += s.games;
+    wins += s.wins;
+    totalScore += s.totalScore;
+    totalDurationMs += s.totalDurationMs;
+    bestWpm = qMax(bestWpm, s.bestWpm);
+    accuracySum += s.accuracySum;
+    accuracyCount += s.accuracyCount;
+}
+
+class GameStats::CompactTask : public QRunnable {
+public:
+    CompactTask(GameStats* stats, const QVector<QByteArray>& payloads) : m_stats(stats), m_payloads(payloads) {}
+    void run() override { m_stats->runCompaction(m_payloads); }
+
+private:
+    GameStats* m_stats;
+    QVector<QByteArray> m_payloads;
+};
+
+GameStats& GameStats::instance() {
+    static GameStats instance;
+    return instance;
+}
+
+GameStats::GameStats() : m_log(STATS_MAGIC, STATS_VERSION), m_compacting(false) {
+    m_pool.setMaxThreadCount(1);
+
+    m_player = QString::fromLocal8Bit(qgetenv("USERNAME"));
+    if (m_player.isEmpty()) m_player = QString::fromLocal8Bit(qgetenv("USER"));
+    if (m_player.isEmpty()) m_player = "Player";
+
+    QString dir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath() : QString(".");
+    m_log.setFileName(dir + "/stats.dat");
+    load();
+}
+
+GameStats::~GameStats() {
+    m_pool.waitForDone();
+}
+
+void GameStats::setFileName(const QString& path) {
+    m_pool.waitForDone();
+    m_log.setFileName(path);
+    load();
+}
+
+void GameStats::setPlayerName(const QString& name) {
+    QString trimmed = name.trimmed();
+    if (!trimmed.isEmpty()) m_player = trimmed;
+}
+
+QString GameStats::entryKey(const QString& game, const QString& player) {
+    return game + QLatin1Char('\n') + player;
+}
+
+void GameStats::attach(GameBase* game) {
+    // 以游戏对象为上下文，游戏销毁时连接自动断开
+    QObject::connect(game, &GameBase::gameFinished, game, [this, game](int score, bool win) {
+        GameRecord r;
+        r.game = game->gameId();
+        r.player = m_player;
+        r.score = score;
+        r.win = win;
+        r.durationMs = game->sessionDurationMs();
+        r.difficulty = game->difficulty();
+        r.timestamp = QDateTime::currentMSecsSinceEpoch();
+
+        int keystrokes = game->sessionKeystrokes();
+        int correct = game->sessionCorrectKeystrokes();
+        if (keystrokes > 0) r.accuracy = double(correct) / keystrokes;
+        if (r.durationMs > 0) r.wpm = (correct / 5.0) / (r.durationMs / 60000.0);
+        record(r);
+    });
+}
+
+void GameStats::load() {
+    m_entries.clear();
+    RecordLog::LoadResult result = m_log.load([this](const QByteArray& payload) {
+        QDataStream in(payload);
+        in.setVersion(QDataStream::Qt_5_0);
+        quint8 type;
+        in >> type;
+        if (type == RECORD_RESULT) {
+            GameRecord r;
+            qint32 score, difficulty;
+            qint64 duration, timestamp;
+            in >> r.game >> r.player >> score >> r.win >> r.accuracy >> r.wpm >> duration >> difficulty >> timestamp;
+            if (in.status() != QDataStream::Ok) return;
+            r.score = score;
+            r.durationMs = duration;
+            r.difficulty = difficulty;
+            r.timestamp = timestamp;
+            index(r);
+        }
+        else if (type == RECORD_SUMMARY) {
+            QString game, player;
+            PlayerSummary s;
+            qint32 games, wins, best, accuracyCount;
+            qint64 totalScore, totalDuration;
+            in >> game >> player >> games >> wins >> totalScore >> best >> totalDuration
+                >> s.bestWpm >> s.accuracySum >> accuracyCount;
+            if (in.status() != QDataStream::Ok) return;
+            s.games = games;
+            s.wins = wins;
+            s.totalScore = totalScore;
+            s.bestScore = best;
+            s.totalDurationMs = totalDuration;
+            s.accuracyCount = accuracyCount;
+
+            Entry& e = m_entries[entryKey(game, player)];
+            e.game = game;
+            e.player = player;
+            e.total.add(s);
+            e.folded.add(s);
+        }
+    });
+
+    if (result == RecordLog::OpenFailed) {
+        // 打不开（被占用、没有权限）：文件原样保留，本次只在内存里统计
+        return;
+    }
+    if (result == RecordLog::BadHeader) {
+        // 无法识别的文件：挪到 .bak 留给人工处理，重新开始
+        m_entries.clear();
+        m_log.discard();
+        return;
+    }
+    scheduleCompaction();
+}
+
+void GameStats::index(const GameRecord& record) {
+    Entry& e = m_entries[entryKey(record.game, record.player)];
+    e.game = record.game;
+    e.player = record.player;
+    e.total.add(record);
+    e.recent.append(record);
+    if (e.recent.size() > RecentCount) e.folded.add(e.recent.takeFirst());
+}
+
+void GameStats::record(const GameRecord& record) {
+    index(record);
+    ScoreStore::instance().addScore(record.game, 0, record.player, record.score);
+
+    QByteArray payload = encodeResult(record);
+    {
+        QMutexLocker locker(&m_logMutex);
+        if (m_compacting) m_tail.append(payload);
+        else m_log.append(payload);
+    }
+    scheduleCompaction();
+}
+
+PlayerSummary GameStats::summary(const QString& game, const QString& player) const {
+    auto it = m_entries.constFind(entryKey(game, player));
+    return it == m_entries.constEnd() ? PlayerSummary() : it->total;
+}
+
+QVector<GameRecord> GameStats::history(const QString& game, const QString& player) const {
+    auto it = m_entries.constFind(entryKey(game, player));
+    return it == m_entries.constEnd() ? QVector<GameRecord>() : it->recent;
+}
+
+QStringList GameStats::players(const QString& game) const {
+    QStringList result;
+    for (const Entry& e : m_entries) {
+        if (e.game == game) result.append(e.player);
+    }
+    return result;
+}
+
+void GameStats::scheduleCompaction() {
+    int retained = 0;
+    for (const Entry& e : m_entries) retained += 1 + e.recent.size();
+
+    {
+        QMutexLocker locker(&m_logMutex);
+        if (m_compacting || m_log.recordCount() <= retained * 2 + 256) return;
+        m_compacting = true;
+        m_tail.clear();
+    }
+
+    // 快照在主线程生成，后台线程只负责写文件
+    QVector<QByteArray> payloads;
+    payloads.reserve(retained);
+    for (const Entry& e : m_entries) {
+        if (e.folded.games > 0) payloads.append(encodeSummary(e.game, e.player, e.folded));
+        for (const GameRecord& r : e.recent) payloads.append(encodeResult(r));
+    }
+    m_pool.start(new CompactTask(this, payloads));
+}
+
+void GameStats::runCompaction(const QVector<QByteArray>& payloads) {
+    int taken;
+    QVector<QByteArray> all = payloads;
+    {
+        QMutexLocker locker(&m_logMutex);
+        taken = m_tail.size();
+        all += m_tail;
+    }
+
+    bool ok = m_log.rewrite(all);
+
+    // 重写期间新提交的记录补写到末尾；重写失败时旧文件不变，全部补写
+    QMutexLocker locker(&m_logMutex);
+    for (int i = ok ? taken : 0; i < m_tail.size(); ++i) m_log.append(m_tail[i]);
+    m_tail.clear();
+    m_compacting = false;
+}
@@ -0,0 +1,117 @@
+﻿#ifndef GAMESTATS_H
+#define GAMESTATS_H
+
+#include "gamecore_global.h"
+#include "recordlog.h"
+#include "scorestore.h"
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVector>
+
+class GameBase;
+
+// 一局的结果
+struct GameRecord {
+    QString game;
+    QString player;
+    int score;
+    bool win;
+    double accuracy;    // 命中按键 / 全部按键，0-1；没有按键时为 -1
+    double wpm;         // 每分钟单词数（按 5 个字符一词计）
+    qint64 durationMs;
+    int difficulty;
+    qint64 timestamp;   // 毫秒，UTC
+
+    GameRecord() : score(0), win(false), accuracy(-1.0), wpm(0.0), durationMs(0), difficulty(1), timestamp(0) {}
+};
+
+// 某玩家在某游戏上的累计数据
+struct PlayerSummary {
+    int games;
+    int wins;
+    qint64 totalScore;
+    int bestScore;
+    qint64 totalDurationMs;
+    double bestWpm;
+    double accuracySum;  // 只累计有按键的局
+    int accuracyCount;
+
+    PlayerSummary() : games(0), wins(0), totalScore(0), bestScore(0), totalDurationMs(0),
+        bestWpm(0.0), accuracySum(0.0), accuracyCount(0) {}
+
+    void add(const GameRecord& r);
+    void add(const PlayerSummary& s);
+    double averageAccuracy() const { return accuracyCount > 0 ? accuracySum / accuracyCount : -1.0; }
+};
+
+// 五个游戏共用的成绩与统计服务
+// attach() 之后，游戏每次发出 gameFinished 都会生成一条 GameRecord：
+// 写入只追加的 stats.dat，同时更新内存索引（每人每游戏的累计数据和最近
+// RecentCount 局），并把分数提交给 ScoreStore 的排行榜。
+// 日志条数超过索引所需的若干倍时，在后台线程用 QSaveFile 重写：
+// 旧的局合并成一条累计记录，只保留最近的明细。
+class GAMECORE_EXPORT GameStats {
+public:
+    static GameStats& instance();
+
+    static const int RecentCount = 50;
+
+    // 监听该游戏的 gameFinished
+    void attach(GameBase* game);
+
+    // 当前玩家名（太空游戏结算时输入的名字，默认取系统用户名）
+    QString playerName() const { return m_player; }
+    void setPlayerName(const QString& name);
+
+    void record(const GameRecord& record);
+
+    PlayerSummary summary(const QString& game, const QString& player) const;
+    // 最近的若干局，按时间先后
+    QVector<GameRecord> history(const QString& game, const QString& player) const;
+    QStringList players(const QString& game) const;
+    QVector<ScoreEntry> leaderboard(const QString& game, int count) const {
+        return ScoreStore::instance().topScores(game, 0, count);
+    }
+
+    // 测试/基准用：改用指定文件并重新加载
+    void setFileName(const QString& path);
+    // 等待后台压缩完成（退出前调用）
+    void waitForIdle() { m_pool.waitForDone(); }
+
+private:
+    GameStats();
+    ~GameStats();
+    GameStats(const GameStats&) = delete;
+    GameStats& operator=(const GameStats&) = delete;
+
+    class CompactTask;
+
+    struct Entry {
+        QString game;
+        QString player;
+        PlayerSummary total;
+        PlayerSummary folded;         // 已滚出 recent 的局，压缩时写成一条累计记录
+        QVector<GameRecord> recent;
+    };
+
+    static QString entryKey(const QString& game, const QString& player);
+    void load();
+    void index(const GameRecord& record);
+    void scheduleCompaction();
+    void runCompaction(const QVector<QByteArray>& payloads); // 在后台线程执行
+
+    RecordLog m_log;
+    QHash<QString, Entry> m_entries;
+    QString m_player;
+
+    // 后台压缩期间的追加先放在 m_tail，压缩完成后补写到新文件末尾
+    QThreadPool m_pool;
+    QMutex m_logMutex;
+    bool m_compacting;
+    QVector<QByteArray> m_tail;
+};
+
+#endif // GAMESTATS_H
@@ -0,0 +1,116 @@
+﻿#include "gametrace.h"
+
+#ifdef GAME_TRACE_ENABLED
+
+#include <QCoreApplication>
+#include <QDialog>
+#include <QThread>
+#include <QMutexLocker>
+#include <QDebug>
+
+// 缓冲达到该数量时落盘，避免长时间会话占用过多内存
+const int TRACE_FLUSH_THRESHOLD = 4096;
+
+GameTrace& GameTrace::instance() {
+    static GameTrace instance;
+    return instance;
+}
+
+GameTrace::GameTrace() : m_fileFailed(false), m_hasWritten(false), m_finished(false) {
+    m_events.reserve(TRACE_FLUSH_THRESHOLD);
+    m_clock.start();
+}
+
+GameTrace::~GameTrace() {
+    flush(true);
+}
+
+bool GameTrace::openFile() {
+    if (m_file.isOpen()) return true;
+    if (m_fileFailed) return false;
+
+    // 输出路径：优先环境变量 GAME_TRACE_FILE，否则放在程序目录下
+    QString path = QString::fromLocal8Bit(qgetenv("GAME_TRACE_FILE"));
+    if (path.isEmpty()) {
+        QString dir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath() : QString(".");
+        path = dir + "/game_trace.json";
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "GameTrace: cannot open" << path;
+        m_fileFailed = true;
+        return false;
+    }
+    m_file.write("[\n");
+    return true;
+}
+
+void GameTrace::addComplete(const char* name, double startUs, double durUs) {
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) return;
+
+    Event e;
+    e.name = name;
+    e.startUs = startUs;
+    e.durUs = durUs;
+    e.tid = (quint64)(quintptr)QThread::currentThreadId();
+    m_events.append(e);
+
+    if (m_events.size() >= TRACE_FLUSH_THRESHOLD) {
+        locker.unlock();
+        // 落盘本身也记一个片段，方便在时间线上区分追踪开销
+        double flushStart = nowUs();
+        flush();
+        locker.relock();
+        Event f;
+        f.name = "GameTrace::flush";
+        f.startUs = flushStart;
+        f.durUs = nowUs() - flushStart;
+        f.tid = e.tid;
+        m_events.append(f);
+    }
+}
+
+void GameTrace::flush(bool finish) {
+    QMutexLocker locker(&m_mutex);
+    if (m_finished) return;
+
+    if (!openFile()) {
+        m_events.clear();
+        return;
+    }
+
+    QByteArray out;
+    out.reserve(m_events.size() * 96);
+    for (const Event& e : m_events) {
+        if (m_hasWritten) out += ",\n";
+        out += "{\"name\":\"";
+        out += e.name;
+        out += "\",\"cat\":\"game\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+        out += QByteArray::number(e.tid);
+        out += ",\"ts\":";
+        out += QByteArray::number(e.startUs, 'f', 3);
+        out += ",\"dur\":";
+        out += QByteArray::number(e.durUs, 'f', 3);
+        out += "}";
+        m_hasWritten = true;
+    }
+    m_events.clear();
+
+    if (finish) {
+        out += "\n]\n";
+        m_finished = true;
+    }
+
+    m_file.write(out);
+    m_file.flush();
+    if (finish) m_file.close();
+}
+
+int GameTrace::tracedExec(QDialog& dialog, const char* name) {
+    TraceScope scope(name);
+    return dialog.exec();
+}
+
+#endif // GAME_TRACE_ENABLED
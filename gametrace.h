@@ -0,0 +1,88 @@
+﻿#ifndef GAMETRACE_H
+#define GAMETRACE_H
+
+// 性能追踪：在关键路径上打 Chrome Trace 格式的时间片段，
+// 输出的 JSON 可直接拖进 chrome://tracing 或 ui.perfetto.dev 查看。
+// 仅在 CMake 打开 ENABLE_GAME_TRACE 时编译进来，关闭时所有宏展开为空。
+
+#ifdef GAME_TRACE_ENABLED
+
+#include "gamecore_global.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QVector>
+
+class QDialog;
+
+class GAMECORE_EXPORT GameTrace {
+public:
+    static GameTrace& instance();
+
+    // 当前时间（微秒，从追踪开始计）
+    double nowUs() const { return m_clock.nsecsElapsed() / 1000.0; }
+
+    // 记录一个完整片段 (Chrome trace 的 "X" 事件)，name 必须是字符串字面量
+    void addComplete(const char* name, double startUs, double durUs);
+
+    // 带追踪的模态对话框
+    static int tracedExec(QDialog& dialog, const char* name);
+
+    // 把缓冲写入文件；finish 为 true 时补上 JSON 数组结尾
+    void flush(bool finish = false);
+
+private:
+    GameTrace();
+    ~GameTrace();
+    GameTrace(const GameTrace&) = delete;
+    GameTrace& operator=(const GameTrace&) = delete;
+
+    bool openFile();
+
+    struct Event {
+        const char* name;
+        double startUs;
+        double durUs;
+        quint64 tid;
+    };
+
+    QElapsedTimer m_clock;
+    QMutex m_mutex;
+    QVector<Event> m_events;
+    QFile m_file;
+    bool m_fileFailed;
+    bool m_hasWritten;
+    bool m_finished;
+};
+
+// 作用域计时器：构造时记开始，析构时提交片段
+class GAMECORE_EXPORT TraceScope {
+public:
+    explicit TraceScope(const char* name)
+        : m_name(name), m_startUs(GameTrace::instance().nowUs()) {}
+    ~TraceScope() {
+        GameTrace& trace = GameTrace::instance();
+        trace.addComplete(m_name, m_startUs, trace.nowUs() - m_startUs);
+    }
+
+private:
+    const char* m_name;
+    double m_startUs;
+};
+
+#define GAME_TRACE_CONCAT_INNER(a, b) a##b
+#define GAME_TRACE_CONCAT(a, b) GAME_TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_SCOPE(name) TraceScope GAME_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define TRACE_EXEC(dialog, name) GameTrace::tracedExec((dialog), (name))
+#define TRACE_FINISH() GameTrace::instance().flush(true)
+
+#else
+
+#define TRACE_SCOPE(name) do {} while (0)
+#define TRACE_EXEC(dialog, name) (dialog).exec()
+#define TRACE_FINISH() do {} while (0)
+
+#endif // GAME_TRACE_ENABLED
+
+#endif // GAMETRACE_H
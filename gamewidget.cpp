@@ -1,491 +1,506 @@
-﻿#include "gamewidget.h"
-#include "gameresultdialog.h"
-#include "confirmationdialog.h"
-#include "policegamesettings.h"
-#include <QVBoxLayout>
-#include <QMessageBox>
-#include <QPainter>
-
-GameWidget::GameWidget(QWidget* parent)
-    : QWidget(parent), m_appState(MainMenu), m_currentGame(nullptr)
-{
-    setFixedSize(800, 600); // 固定窗口大小
-    setWindowTitle(QStringLiteral("金山打字通重制版 - C++实战"));
-
-    m_renderTimer = new QTimer(this);
-    m_renderTimer->setInterval(16); // 约 60 FPS
-    connect(m_renderTimer, &QTimer::timeout, this, QOverload<>::of(&QWidget::update));
-
-    m_moleGame = new MoleGame(this);
-    m_policeGame = new PoliceGame(this);
-    m_spaceGame = new SpaceGame(this);
-    m_appleGame = new AppleGame(this);
-    m_frogGame = new FrogGame(this);
-    m_policeSettingsDialog = new PoliceGameSettings(this);
-
-    m_settingsDialog = new GameSettings(this);
-    m_appleSettingsDialog = new AppleGameSettings(this);
-    m_frogSettingsDialog = new FrogGameSettings(this);
-
-    setupMainMenu();
-    setupGameUI(); // 先创建但不显示
-    
-    // 默认显示主菜单
-    onReturnToMenu();
-
-    this->setFocusPolicy(Qt::StrongFocus);
-
-    
-}
-
-GameWidget::~GameWidget() {
-}
-
-void GameWidget::setupMainMenu() {
-    m_titleLabel = new QLabel(QStringLiteral("请选择游戏"), this);
-    m_titleLabel->setStyleSheet("font-size: 24px; font-weight: bold; color: #333;");
-    m_titleLabel->move(350, 100);
-
-    m_btnMole = new QPushButton(QStringLiteral("鼠的故事"), this);
-    m_btnMole->setGeometry(300, 200, 200, 50);
-    connect(m_btnMole, &QPushButton::clicked, this, &GameWidget::onSelectMoleGame);
-
-    m_btnPolice = new QPushButton(QStringLiteral("生死时速"), this);
-    m_btnPolice->setGeometry(300, 260, 200, 50);
-    connect(m_btnPolice, &QPushButton::clicked, this, &GameWidget::onSelectPoliceGame);
-
-    m_btnSpace = new QPushButton(QStringLiteral("太空大战"), this);
-    m_btnSpace->setGeometry(300, 320, 200, 50); 
-    connect(m_btnSpace, &QPushButton::clicked, this, &GameWidget::onSelectSpaceGame);
-
-    m_btnApple = new QPushButton(QStringLiteral("拯救苹果"), this);
-    m_btnApple->setGeometry(300, 380, 200, 50); 
-    connect(m_btnApple, &QPushButton::clicked, this, &GameWidget::onSelectAppleGame);
-
-    m_btnFrog = new QPushButton(QStringLiteral("激流勇进"), this);
-    m_btnFrog->setGeometry(300, 440, 200, 50); // 调整位置
-    connect(m_btnFrog, &QPushButton::clicked, this, &GameWidget::onSelectFrogGame);
-
-    m_btnExit = new QPushButton(QStringLiteral("退出程序"), this);
-    m_btnExit->setGeometry(300, 500, 200, 50);
-    connect(m_btnExit, &QPushButton::clicked, this, &GameWidget::onExitApp);
-}
-
-void GameWidget::setupGameUI() {
-    m_btnStart = new ImageButton(":/img/public_start.bmp", ":/img/public_start_on.bmp", ":/img/public_start_clicked.bmp", this);
-    m_btnStart->move(490, 530);
-    connect(m_btnStart, &ImageButton::clicked, this, &GameWidget::onStartGame);
-
-    m_btnPause = new ImageButton(":/img/public_pause.bmp", ":/img/public_pause_on.bmp", ":/img/public_pause_clicked.bmp", this);
-    m_btnPause->move(400, 510);
-    connect(m_btnPause, &ImageButton::clicked, this, &GameWidget::onPauseGame);
-
-    m_btnEnd = new ImageButton(":/img/public_end.bmp", ":/img/public_end_on.bmp", ":/img/public_end_clicked.bmp", this);
-    m_btnEnd->move(450, 480); // 放在控制面板区域
-    connect(m_btnEnd, &ImageButton::clicked, this, &GameWidget::onStopGameRound);
-
-    m_btnSettings = new ImageButton(":/img/public_settings.bmp", ":/img/public_settings_on.bmp", ":/img/public_settings_clicked.bmp", this);
-    m_btnSettings->move(440, 550);
-    connect(m_btnSettings, &ImageButton::clicked, this, &GameWidget::onShowSettings);
-
-    m_btnQuitGame = new ImageButton(":/img/public_exit.bmp", ":/img/public_exit_on.bmp", ":/img/public_exit_clicked.bmp", this);
-    m_btnQuitGame->move(40, 550); // 左下角位置
-    connect(m_btnQuitGame, &ImageButton::clicked, this, &GameWidget::onReturnToMenu);
-}
-
-void GameWidget::onStopGameRound() {
-    if (m_currentGame) {
-        m_currentGame->stopGame();
-
-        update();
-
-        // 更新按钮状态
-        updateButtons();
-    }
-}
-
-void GameWidget::onReturnToMenu() {
-    if (m_appState == InGame) {
-        bool wasRunning = false;
-        if (m_renderTimer->isActive()) {
-            m_renderTimer->stop();
-            wasRunning = true;
-        }
-
-        // 弹出确认对话框
-        ConfirmationDialog dlg(ConfirmationDialog::Mode_ExitGame, this);
-        if (dlg.exec() == QDialog::Rejected) {
-            if (wasRunning) m_renderTimer->start(); // 恢复游戏
-            return;
-        }
-    }
-
-    m_renderTimer->stop();
-
-    m_appState = MainMenu;
-    if (m_currentGame) {
-        m_currentGame->stopGame();
-        m_currentGame->disconnect(this);
-        m_currentGame = nullptr;
-    }
-
-    // 显示菜单控件
-    m_titleLabel->show();
-    m_btnMole->show();
-    m_btnPolice->show();
-    m_btnSpace->show();
-    m_btnApple->show();
-    m_btnFrog->show();
-    m_btnExit->show();
-
-    // 隐藏游戏控件
-    m_btnStart->hide();
-    m_btnPause->hide();
-    m_btnEnd->hide();       
-    m_btnSettings->hide();
-    m_btnQuitGame->hide();  
-
-    update(); 
-}
-
-void GameWidget::switchToGame(GameBase* game) {
-    m_appState = InGame;
-    m_currentGame = game;
-
-    // 连接信号
-    connect(m_currentGame, &GameBase::gameFinished, this, &GameWidget::onGameFinished);
-    connect(m_currentGame, &GameBase::scoreChanged, this, &GameWidget::onScoreChanged);
-
-    // 隐藏主菜单
-    m_titleLabel->hide();
-    m_btnMole->hide();
-    m_btnPolice->hide();
-    m_btnSpace->hide();
-    m_btnApple->hide();
-    m_btnFrog->hide();
-    m_btnExit->hide();
-
-    SpaceGame* spaceGame = dynamic_cast<SpaceGame*>(game);
-
-
-
-    if (spaceGame) {
-        m_btnStart->hide();
-        m_btnPause->hide();
-        m_btnEnd->hide();
-        m_btnSettings->hide();
-        m_btnQuitGame->hide();
-
-        // 连接 SpaceGame 特有的退出信号
-        disconnect(spaceGame, &SpaceGame::requestReturnToMenu, this, &GameWidget::onReturnToMenu);
-        connect(spaceGame, &SpaceGame::requestReturnToMenu, this, &GameWidget::onReturnToMenu);
-    }
-    else if (game == m_policeGame) {
-        m_btnStart->hide();
-        m_btnPause->hide();
-        m_btnEnd->hide();
-        m_btnSettings->hide();
-
-        m_btnQuitGame->show();
-        // 加载通用退出按钮资源
-        m_btnQuitGame->loadImages(":/img/public_exit.bmp", ":/img/public_exit_on.bmp", ":/img/public_exit_clicked.bmp");
-        m_btnQuitGame->move(40, 550); // 左下角位置
-    }
-    else {
-        m_btnStart->show();
-        m_btnPause->show();
-        m_btnEnd->show();
-        m_btnSettings->show();
-        m_btnQuitGame->show();
-
-        if (game == m_frogGame) {
-            m_btnStart->loadImages(":/img/frog_start.png", ":/img/frog_start_hover.png", ":/img/frog_start_pressed.png");
-            m_btnPause->loadImages(":/img/frog_pause.png", ":/img/frog_pause_hover.png", ":/img/frog_pause_pressed.png");
-            m_btnEnd->loadImages(":/img/frog_end.png", ":/img/frog_end_hover.png", ":/img/frog_end_pressed.png");
-            m_btnSettings->loadImages(":/img/frog_setting.png", ":/img/frog_setting_hover.png", ":/img/frog_setting_pressed.png");
-            m_btnQuitGame->loadImages(":/img/frog_exit.png", ":/img/frog_exit_hover.png", ":/img/frog_exit_pressed.png");
-
-            m_btnStart->move(160, 480);
-            m_btnPause->move(120, 510);
-            m_btnEnd->move(200, 530);
-            m_btnSettings->move(150, 550);
-            m_btnQuitGame->move(20, 550);
-        }
-        else {
-            m_btnStart->loadImages(":/img/public_start.bmp", ":/img/public_start_on.bmp", ":/img/public_start_clicked.bmp");
-            m_btnPause->loadImages(":/img/public_pause.bmp", ":/img/public_pause_on.bmp", ":/img/public_pause_clicked.bmp");
-            m_btnEnd->loadImages(":/img/public_end.bmp", ":/img/public_end_on.bmp", ":/img/public_end_clicked.bmp");
-            m_btnSettings->loadImages(":/img/public_settings.bmp", ":/img/public_settings_on.bmp", ":/img/public_settings_clicked.bmp");
-            m_btnQuitGame->loadImages(":/img/public_exit.bmp", ":/img/public_exit_on.bmp", ":/img/public_exit_clicked.bmp");
-
-            if (game == m_moleGame) {
-                m_btnEnd->move(450, 480);
-                m_btnPause->move(400, 510);
-                m_btnStart->move(490, 530);
-                m_btnSettings->move(440, 550);
-                m_btnQuitGame->move(40, 550);
-            }
-            else {
-                m_btnStart->move(160, 480);
-                m_btnPause->move(120, 510);
-                m_btnEnd->move(200, 530);
-                m_btnSettings->move(150, 550);
-                m_btnQuitGame->move(20, 550);
-            }
-        }
-    }
-
-    // 初始化游戏
-    m_currentGame->initGame();
-
-    m_renderTimer->start();
-
-    updateButtons();
-    update(); // 触发重绘
-}
-
-void GameWidget::onSelectMoleGame() {
-    switchToGame(m_moleGame);
-}
-
-void GameWidget::onSelectPoliceGame() {
-    // 创建并显示设置窗口
-    PoliceGameSettings settingsDlg(this);
-
-    if (settingsDlg.exec() == QDialog::Accepted) {
-        // 获取设置数据
-        PoliceSettingsData data = settingsDlg.getSettings();
-
-        // 切换到游戏界面
-        switchToGame(m_policeGame);
-
-        // 应用设置并初始化
-        m_policeGame->updateSettings(data);
-        m_policeGame->initGame();
-
-    }
-}
-
-void GameWidget::onSelectSpaceGame() {
-    switchToGame(m_spaceGame);
-}
-
-void GameWidget::onSelectAppleGame() {
-    switchToGame(m_appleGame);
-}
-
-void GameWidget::onSelectFrogGame() {
-    switchToGame(m_frogGame);
-}
-
-void GameWidget::onStartGame() {
-    if (m_currentGame) {
-        m_currentGame->startGame();
-
-        if (!m_renderTimer->isActive()) {
-            m_renderTimer->start();
-        }
-
-        updateButtons();
-        setFocus(); // 确保能接收键盘事件
-    }
-}
-
-void GameWidget::onPauseGame() {
-    if (m_currentGame) {
-        m_currentGame->pauseGame();
-
-        // 根据游戏状态控制渲染
-        if (m_currentGame->getState() == GameState::Paused) {
-            m_renderTimer->stop(); // 暂停时不刷新，画面静止
-            update(); // 额外刷新一次以显示暂停状态（如果有）
-        }
-        else {
-            m_renderTimer->start();
-        }
-        updateButtons();
-    }
-}
-
-
-void GameWidget::onShowSettings() {
-    MoleGame* moleGame = dynamic_cast<MoleGame*>(m_currentGame);
-    if (moleGame) {
-        GameSettingsData oldSettings = m_settingsDialog->getSettings();
-        if (m_settingsDialog->exec() == QDialog::Accepted) {
-            GameSettingsData newSettings = m_settingsDialog->getSettings();
-            bool changed = (oldSettings.gameTimeSec != newSettings.gameTimeSec) ||
-                 (oldSettings.spawnIntervalMs != newSettings.spawnIntervalMs) ||
-                 (oldSettings.stayTimeMs != newSettings.stayTimeMs);
-            if (changed) {
-                ConfirmationDialog dlg(ConfirmationDialog::Mode_ApplySettings, this);
-                if (dlg.exec() == QDialog::Accepted) {
-                    moleGame->updateSettings(newSettings);
-                    moleGame->initGame();
-                    onStartGame();
-                }
-                else {
-                    moleGame->updateSettings(newSettings);
-                }
-            }
-        }
-        return;
-    }
-
-    // 判断是否是苹果游戏
-    AppleGame* appleGame = dynamic_cast<AppleGame*>(m_currentGame);
-    if (appleGame) {
-        AppleSettingsData oldSettings = m_appleSettingsDialog->getSettings();
-
-        if (m_appleSettingsDialog->exec() == QDialog::Accepted) {
-            AppleSettingsData newSettings = m_appleSettingsDialog->getSettings();
-
-            // 简单比较是否改变
-            bool changed = (oldSettings.level != newSettings.level) ||
-                (oldSettings.targetCount != newSettings.targetCount) ||
-                (oldSettings.failCount != newSettings.failCount);
-
-            if (changed) {
-                ConfirmationDialog dlg(ConfirmationDialog::Mode_ApplySettings, this);
-                if (dlg.exec() == QDialog::Accepted) {
-                    appleGame->updateSettings(newSettings);
-                    appleGame->initGame();
-                    onStartGame();
-                }
-                else {
-                    appleGame->updateSettings(newSettings);
-                }
-            }
-        }
-        return;
-    }
-
-    FrogGame* frogGame = dynamic_cast<FrogGame*>(m_currentGame);
-    if (frogGame) {
-        FrogSettingsData oldSettings = m_frogSettingsDialog->getSettings();
-
-        if (m_frogSettingsDialog->exec() == QDialog::Accepted) {
-            FrogSettingsData newSettings = m_frogSettingsDialog->getSettings();
-
-            // 判断是否需要重启
-            bool changed = (oldSettings.difficulty != newSettings.difficulty) ||
-                (oldSettings.dictionaryFile != newSettings.dictionaryFile);
-
-            if (changed) {
-                ConfirmationDialog dlg(ConfirmationDialog::Mode_ApplySettings, this);
-                if (dlg.exec() == QDialog::Accepted) {
-                    frogGame->updateSettings(newSettings); // 传入设置
-                    frogGame->initGame(); // 重置游戏
-                    onStartGame();
-                }
-                else {
-                    frogGame->updateSettings(newSettings); // 仅更新参数
-                }
-            }
-        }
-        return;
-    }
-
-    PoliceGame* policeGame = dynamic_cast<PoliceGame*>(m_currentGame);
-    if (policeGame) {
-        // 弹出设置框
-        if (m_policeSettingsDialog->exec() == QDialog::Accepted) {
-            PoliceSettingsData data = m_policeSettingsDialog->getSettings();
-            ConfirmationDialog dlg(ConfirmationDialog::Mode_ApplySettings, this);
-            if (dlg.exec() == QDialog::Accepted) {
-                policeGame->updateSettings(data);
-                policeGame->initGame(); // 重置游戏应用新角色/难度
-                onStartGame();
-            }
-        }
-        return;
-    }
-}
-
-void GameWidget::updateButtons() {
-    if (!m_currentGame) return;
-
-    GameState state = m_currentGame->getState();
-
-    m_btnStart->setEnabled(state == GameState::Ready || state == GameState::GameOver);
-
-    m_btnPause->setEnabled(state == GameState::Playing || state == GameState::Paused);
-
-    m_btnEnd->setEnabled(state == GameState::Playing || state == GameState::Paused);
-
-    m_btnSettings->setEnabled(state == GameState::Ready || state == GameState::GameOver);
-
-    m_btnQuitGame->setEnabled(true);
-}
-
-void GameWidget::paintEvent(QPaintEvent* event) {
-    QPainter painter(this);
-
-    if (m_appState == MainMenu) {
-        // 绘制简单的菜单背景
-        painter.fillRect(rect(), QColor(240, 240, 240));
-    }
-    else if (m_appState == InGame && m_currentGame) {
-        m_currentGame->draw(painter);
-    }
-}
-
-void GameWidget::keyPressEvent(QKeyEvent* event) {
-    if (m_appState == InGame && m_currentGame) {
-        if (event->key() == Qt::Key_Space) {
-            m_currentGame->handleKeyPress(event);
-            return; // 阻止事件传播
-        }
-
-        m_currentGame->handleKeyPress(event);
-        update();
-    }
-}
-
-void GameWidget::onGameFinished(int score, bool win) {
-    if (m_renderTimer->isActive()) {
-        m_renderTimer->stop();
-    }
-
-    GameResultDialog::GameTheme theme = GameResultDialog::Theme_Mole; // 默认
-
-    if (dynamic_cast<AppleGame*>(m_currentGame)) {
-        theme = GameResultDialog::Theme_Apple;
-    }
-    else if (dynamic_cast<FrogGame*>(m_currentGame)) {
-        theme = GameResultDialog::Theme_Frog;
-    }
-    else if (dynamic_cast<PoliceGame*>(m_currentGame)) {
-        theme = GameResultDialog::Theme_Police; // 识别警察游戏
-    }
-
-    GameResultDialog dlg(theme, this);
-
-    PoliceGame* policeGame = dynamic_cast<PoliceGame*>(m_currentGame);
-    if (policeGame) {
-        dlg.setRole(policeGame->getRole());
-    }
-
-    dlg.setGameResult(score, win);
-    dlg.exec();
-
-    GameResultDialog::ResultAction action = dlg.getSelectedAction();
-    if (action == GameResultDialog::Action_Replay) {
-        onStartGame();
-    }
-    else if (action == GameResultDialog::Action_NextLevel) {
-        MoleGame* moleGame = dynamic_cast<MoleGame*>(m_currentGame);
-        if (moleGame) moleGame->increaseDifficulty();
-        onStartGame();
-    }
-    else {
-        onStopGameRound();
-    }
-}
-void GameWidget::onScoreChanged(int score) {
-
-}
-
-void GameWidget::onExitApp() {
-    close();
+﻿#include "gamewidget.h"
+#include "gameresultdialog.h"
+#include "confirmationdialog.h"
+#include "gametrace.h"
+#include "gameglview.h"
+#include "assetcache.h"
+#include "gamestats.h"
+#include "difficultycontroller.h"
+#include "gameregistry.h"
+#include "snapshotstore.h"
+#include <QCoreApplication>
+#include <QVBoxLayout>
+#include <QMessageBox>
+#include <QPainter>
+#include <QChildEvent>
+#include <QCloseEvent>
+
+GameWidget::GameWidget(QWidget* parent)
+    : QWidget(parent), m_appState(MainMenu), m_currentGame(nullptr), m_caps(nullptr), m_glView(nullptr),
+    m_viewScale(1.0), m_syncingLayout(false)
+{
+    // 默认按逻辑尺寸显示，允许缩放/全屏，画面等比适配
+    setMinimumSize(SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+    resize(SCREEN_WIDTH, SCREEN_HEIGHT);
+    setWindowTitle(QStringLiteral("金山打字通重制版 - C++实战"));
+
+    m_renderTimer = new QTimer(this);
+    m_renderTimer->setInterval(16); // 约 60 FPS
+    connect(m_renderTimer, &QTimer::timeout, this, QOverload<>::of(&QWidget::update));
+
+    m_autosaveTimer = new QTimer(this);
+    m_autosaveTimer->setInterval(5000);
+    connect(m_autosaveTimer, &QTimer::timeout, this, &GameWidget::suspendCurrentGame);
+
+    // 内置游戏已在注册表里，再登记 games 目录下的插件；游戏本身等选中时才创建
+    GameRegistry::instance().discoverPlugins(QCoreApplication::applicationDirPath() + "/games");
+
+    m_difficulty = new DifficultyController(this);
+
+    setupMainMenu();
+    setupGameUI(); // 先创建但不显示
+    
+    // 默认显示主菜单
+    onReturnToMenu();
+
+    this->setFocusPolicy(Qt::StrongFocus);
+
+    
+}
+
+GameWidget::~GameWidget() {
+}
+
+void GameWidget::setOpenGLEnabled(bool enabled) {
+    if (enabled == (m_glView != nullptr)) return;
+
+    if (enabled) {
+        m_glView = new GameGLView([this](QPainter& painter) { renderFrame(painter); }, this);
+        m_glView->setGeometry(rect());
+        m_glView->lower(); // 放在所有按钮下面
+        m_glView->show();
+        connect(m_glView, &QOpenGLWidget::frameSwapped, this, &GameWidget::onGLFrameSwapped);
+    }
+    else {
+        delete m_glView;
+        m_glView = nullptr;
+    }
+    update();
+}
+
+void GameWidget::setAdaptiveDifficulty(bool enabled) {
+    m_difficulty->setEnabled(enabled);
+}
+
+void GameWidget::onGLFrameSwapped() {
+    // 游戏进行中由交换缓冲驱动下一帧，帧率与显示器刷新同步
+    if (m_glView && m_renderTimer->isActive()) {
+        m_glView->update();
+    }
+}
+
+void GameWidget::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    if (m_glView) m_glView->setGeometry(rect());
+    updateViewTransform();
+}
+
+void GameWidget::updateViewTransform() {
+    m_viewScale = qMin(width() / (qreal)SCREEN_WIDTH, height() / (qreal)SCREEN_HEIGHT);
+    m_viewOffset = QPoint(qRound((width() - SCREEN_WIDTH * m_viewScale) / 2),
+        qRound((height() - SCREEN_HEIGHT * m_viewScale) / 2));
+
+    // 贴图只在比例变化时重新缩放一次
+    AssetCache::instance().setScale(m_viewScale * devicePixelRatioF());
+
+    const QList<QWidget*> children = findChildren<QWidget*>(QString(), Qt::FindDirectChildrenOnly);
+    for (QWidget* child : children) {
+        syncChildGeometry(child);
+    }
+    update();
+}
+
+void GameWidget::syncChildGeometry(QWidget* child) {
+    if (child == m_glView || child->isWindow()) return;
+
+    ChildLayout& layout = m_childLayouts[child];
+    QRect current = child->geometry();
+
+    if (!layout.known) {
+        layout.logical = current;
+        layout.known = true;
+    }
+    else if (current != layout.applied) {
+        // 游戏代码按逻辑坐标 move / resize 过
+        if (current.topLeft() != layout.applied.topLeft()) layout.logical.moveTopLeft(current.topLeft());
+        if (current.size() != layout.applied.size()) layout.logical.setSize(current.size());
+    }
+
+    QRect target(m_viewOffset + QPoint(qRound(layout.logical.x() * m_viewScale), qRound(layout.logical.y() * m_viewScale)),
+        QSize(qRound(layout.logical.width() * m_viewScale), qRound(layout.logical.height() * m_viewScale)));
+    layout.applied = target;
+    if (target == current) return;
+
+    m_syncingLayout = true;
+    if (child->minimumSize() == child->maximumSize()) {
+        child->setFixedSize(target.size()); // ImageButton 等固定尺寸控件
+    }
+    child->setGeometry(target);
+    m_syncingLayout = false;
+}
+
+void GameWidget::childEvent(QChildEvent* event) {
+    QWidget::childEvent(event);
+    if (event->added() && event->child()->isWidgetType()) {
+        event->child()->installEventFilter(this);
+    }
+    else if (event->removed()) {
+        m_childLayouts.remove(event->child());
+    }
+}
+
+bool GameWidget::eventFilter(QObject* watched, QEvent* event) {
+    if (!m_syncingLayout && (event->type() == QEvent::Move || event->type() == QEvent::Resize)
+        && watched->parent() == this) {
+        QWidget* child = qobject_cast<QWidget*>(watched);
+        if (child) syncChildGeometry(child);
+    }
+    return QWidget::eventFilter(watched, event);
+}
+
+void GameWidget::setupMainMenu() {
+    m_titleLabel = new QLabel(QStringLiteral("请选择游戏"), this);
+    m_titleLabel->setStyleSheet("font-size: 24px; font-weight: bold; color: #333;");
+    m_titleLabel->move(350, 100);
+
+    // 每个注册的游戏一个按钮，从 y=200 起每隔 60 排一个；游戏多时缩小间距放得下
+    const QVector<GameInfo> games = GameRegistry::instance().games();
+    const int top = 200, bottom = 560;
+    const int step = qMin(60, (bottom - top) / qMax(1, games.size() + 1));
+    int y = top;
+    for (const GameInfo& info : games) {
+        QPushButton* button = new QPushButton(info.name, this);
+        button->setGeometry(300, y, 200, qMin(50, step - 4));
+        const QString id = info.id;
+        connect(button, &QPushButton::clicked, this, [this, id]() { selectGame(id); });
+        m_gameButtons.append(button);
+        y += step;
+    }
+
+    m_btnExit = new QPushButton(QStringLiteral("退出程序"), this);
+    m_btnExit->setGeometry(300, y, 200, qMin(50, step - 4));
+    connect(m_btnExit, &QPushButton::clicked, this, &GameWidget::onExitApp);
+}
+
+void GameWidget::setupGameUI() {
+    m_btnStart = new ImageButton(":/img/public_start.bmp", ":/img/public_start_on.bmp", ":/img/public_start_clicked.bmp", this);
+    m_btnStart->move(490, 530);
+    connect(m_btnStart, &ImageButton::clicked, this, &GameWidget::onStartGame);
+
+    m_btnPause = new ImageButton(":/img/public_pause.bmp", ":/img/public_pause_on.bmp", ":/img/public_pause_clicked.bmp", this);
+    m_btnPause->move(400, 510);
+    connect(m_btnPause, &ImageButton::clicked, this, &GameWidget::onPauseGame);
+
+    m_btnEnd = new ImageButton(":/img/public_end.bmp", ":/img/public_end_on.bmp", ":/img/public_end_clicked.bmp", this);
+    m_btnEnd->move(450, 480); // 放在控制面板区域
+    connect(m_btnEnd, &ImageButton::clicked, this, &GameWidget::onStopGameRound);
+
+    m_btnSettings = new ImageButton(":/img/public_settings.bmp", ":/img/public_settings_on.bmp", ":/img/public_settings_clicked.bmp", this);
+    m_btnSettings->move(440, 550);
+    connect(m_btnSettings, &ImageButton::clicked, this, &GameWidget::onShowSettings);
+
+    m_btnQuitGame = new ImageButton(":/img/public_exit.bmp", ":/img/public_exit_on.bmp", ":/img/public_exit_clicked.bmp", this);
+    m_btnQuitGame->move(40, 550); // 左下角位置
+    connect(m_btnQuitGame, &ImageButton::clicked, this, &GameWidget::onReturnToMenu);
+}
+
+void GameWidget::onStopGameRound() {
+    if (m_currentGame) {
+        m_currentGame->stopGame();
+        suspendCurrentGame(); // 这一局结束了，删掉它的快照
+
+        update();
+
+        // 更新按钮状态
+        updateButtons();
+    }
+}
+
+void GameWidget::onReturnToMenu() {
+    if (m_appState == InGame) {
+        bool wasRunning = false;
+        if (m_renderTimer->isActive()) {
+            m_renderTimer->stop();
+            wasRunning = true;
+        }
+
+        // 弹出确认对话框
+        ConfirmationDialog dlg(ConfirmationDialog::Mode_ExitGame, this);
+        if (TRACE_EXEC(dlg, "ConfirmationDialog::exec") == QDialog::Rejected) {
+            if (wasRunning) m_renderTimer->start(); // 恢复游戏
+            return;
+        }
+    }
+
+    m_renderTimer->stop();
+    m_autosaveTimer->stop();
+
+    m_appState = MainMenu;
+    if (m_currentGame) {
+        // 没玩完的一局先挂起，下次选中这个游戏时可以继续
+        suspendCurrentGame();
+        m_currentGame->stopGame();
+        m_currentGame->disconnect(this);
+        m_currentGame = nullptr;
+        m_caps = nullptr;
+        m_difficulty->attach(nullptr);
+    }
+
+    // 显示菜单控件
+    setMenuVisible(true);
+
+    // 隐藏游戏控件
+    m_btnStart->hide();
+    m_btnPause->hide();
+    m_btnEnd->hide();       
+    m_btnSettings->hide();
+    m_btnQuitGame->hide();  
+
+    update(); 
+}
+
+void GameWidget::switchToGame(GameBase* game, bool restored) {
+    m_appState = InGame;
+    m_currentGame = game;
+
+    // 连接信号
+    connect(m_currentGame, &GameBase::gameFinished, this, &GameWidget::onGameFinished);
+    connect(m_currentGame, &GameBase::scoreChanged, this, &GameWidget::onScoreChanged);
+    connect(m_currentGame, &GameBase::requestReturnToMenu, this, &GameWidget::onReturnToMenu);
+    // 接管时倍率回到 1.0；从快照恢复的一局沿用快照里的倍率
+    const DifficultyParams params = m_currentGame->difficultyParams();
+    m_difficulty->attach(m_currentGame);
+    if (restored) m_currentGame->setDifficultyParams(params);
+
+    // 隐藏主菜单
+    setMenuVisible(false);
+
+    // HUD 按钮的显示、贴图和位置都由游戏的能力描述决定
+    m_caps = &game->capabilities();
+    applyHudLayout(m_caps->hud);
+
+    // 初始化游戏；从快照恢复的已经处于暂停状态，不能再复位
+    if (!restored) m_currentGame->initGame();
+
+    m_renderTimer->start();
+    m_autosaveTimer->start();
+
+    updateButtons();
+    update(); // 触发重绘
+}
+
+void GameWidget::suspendCurrentGame() {
+    if (!m_currentGame) return;
+    if (m_currentGame->canSuspend()) SnapshotStore::instance().save(m_currentGame->saveSnapshot());
+    else SnapshotStore::instance().remove(m_currentGame->gameId());
+}
+
+void GameWidget::applyHudLayout(const HudLayout& hud) {
+    auto apply = [](ImageButton* button, const HudButton& spec) {
+        if (!spec.visible) {
+            button->hide();
+            return;
+        }
+        button->loadImages(spec.normal, spec.hover, spec.pressed);
+        button->move(spec.pos);
+        button->show();
+    };
+    apply(m_btnStart, hud.start);
+    apply(m_btnPause, hud.pause);
+    apply(m_btnEnd, hud.end);
+    apply(m_btnSettings, hud.settings);
+    apply(m_btnQuitGame, hud.quit);
+}
+
+void GameWidget::setMenuVisible(bool visible) {
+    m_titleLabel->setVisible(visible);
+    for (QPushButton* button : m_gameButtons) button->setVisible(visible);
+    m_btnExit->setVisible(visible);
+}
+
+GameBase* GameWidget::gameFor(const QString& id) {
+    GameBase* game = m_games.value(id);
+    if (game) return game;
+
+    game = GameRegistry::instance().create(id, this);
+    if (!game) return nullptr;
+    // 所有游戏的结算都记入统计
+    GameStats::instance().attach(game);
+    m_games.insert(id, game);
+    return game;
+}
+
+void GameWidget::selectGame(const QString& id) {
+    GameBase* game = gameFor(id);
+    if (!game) {
+        QMessageBox::warning(this, QStringLiteral("错误"), QStringLiteral("无法加载游戏：") + id);
+        return;
+    }
+
+    // 上次挂起的一局：继续的话直接恢复（设置也在快照里），否则丢弃
+    SnapshotStore& snapshots = SnapshotStore::instance();
+    if (snapshots.contains(id)) {
+        QMessageBox::StandardButton answer = QMessageBox::question(this, QStringLiteral("继续游戏"),
+            QStringLiteral("上次还有一局没有玩完，是否继续？"));
+        if (answer == QMessageBox::Yes) {
+            if (game->restoreSnapshot(snapshots.snapshot(id))) {
+                switchToGame(game, true);
+                return;
+            }
+            // 存档损坏或来自旧版本：当作新的一局，照常走下面的设置和开局流程
+            QMessageBox::information(this, QStringLiteral("继续游戏"),
+                QStringLiteral("上次的进度无法恢复，将开始新的一局。"));
+        }
+        snapshots.remove(id);
+    }
+
+    // 需要先选设置的游戏（生死时速选角色和文章），取消就留在主菜单
+    if (game->capabilities().settingsBeforeStart) {
+        if (game->execSettings(this) == GameBase::SettingsRejected) return;
+        game->applySettings();
+    }
+    switchToGame(game);
+}
+
+void GameWidget::onStartGame() {
+    if (m_currentGame) {
+        m_currentGame->startGame();
+
+        if (!m_renderTimer->isActive()) {
+            m_renderTimer->start();
+        }
+
+        updateButtons();
+        setFocus(); // 确保能接收键盘事件
+    }
+}
+
+void GameWidget::onPauseGame() {
+    if (m_currentGame) {
+        m_currentGame->pauseGame();
+
+        // 根据游戏状态控制渲染
+        if (m_currentGame->getState() == GameState::Paused) {
+            m_renderTimer->stop(); // 暂停时不刷新，画面静止
+            update(); // 额外刷新一次以显示暂停状态（如果有）
+        }
+        else {
+            m_renderTimer->start();
+        }
+        updateButtons();
+    }
+}
+
+
+void GameWidget::onShowSettings() {
+    if (!m_currentGame) return;
+    if (m_currentGame->execSettings(this) != GameBase::SettingsChanged) return;
+
+    ConfirmationDialog dlg(ConfirmationDialog::Mode_ApplySettings, this);
+    if (TRACE_EXEC(dlg, "ConfirmationDialog::exec") == QDialog::Accepted) {
+        m_currentGame->applySettings();
+        m_currentGame->initGame(); // 重置游戏
+        onStartGame();
+    }
+    else if (m_caps->keepSettingsWithoutRestart) {
+        m_currentGame->applySettings(); // 仅更新参数
+    }
+}
+
+void GameWidget::updateButtons() {
+    if (!m_currentGame) return;
+
+    GameState state = m_currentGame->getState();
+
+    m_btnStart->setEnabled(state == GameState::Ready || state == GameState::GameOver);
+
+    m_btnPause->setEnabled(state == GameState::Playing || state == GameState::Paused);
+
+    m_btnEnd->setEnabled(state == GameState::Playing || state == GameState::Paused);
+
+    m_btnSettings->setEnabled(state == GameState::Ready || state == GameState::GameOver);
+
+    m_btnQuitGame->setEnabled(true);
+}
+
+void GameWidget::paintEvent(QPaintEvent* event) {
+    if (m_glView) {
+        // OpenGL 模式下由视图自己绘制
+        m_glView->update();
+        return;
+    }
+
+    QPainter painter(this);
+    renderFrame(painter);
+}
+
+void GameWidget::renderFrame(QPainter& painter) {
+    TRACE_SCOPE("GameWidget::renderFrame");
+
+    if (m_appState == MainMenu) {
+        // 绘制简单的菜单背景
+        painter.fillRect(rect(), QColor(240, 240, 240));
+    }
+    else if (m_appState == InGame && m_currentGame) {
+        // 窗口比例与画面不一致时两侧留黑边
+        if (m_viewOffset.x() > 0 || m_viewOffset.y() > 0) {
+            painter.fillRect(rect(), Qt::black);
+        }
+        painter.save();
+        painter.translate(m_viewOffset);
+        painter.scale(m_viewScale, m_viewScale);
+        painter.setClipRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        m_currentGame->draw(painter);
+        painter.restore();
+    }
+}
+
+void GameWidget::keyPressEvent(QKeyEvent* event) {
+    if (m_appState == InGame && m_currentGame) {
+        if (event->key() == Qt::Key_Space) {
+            m_currentGame->handleKeyPress(event);
+            return; // 阻止事件传播
+        }
+
+        m_currentGame->handleKeyPress(event);
+        update();
+    }
+}
+
+void GameWidget::onGameFinished(int score, bool win) {
+    SnapshotStore::instance().remove(m_currentGame->gameId());
+
+    // 没有结算皮肤的游戏（太空大战）自带结算画面
+    if (!m_caps || m_caps->resultTheme.isEmpty()) return;
+
+    if (m_renderTimer->isActive()) {
+        m_renderTimer->stop();
+    }
+
+    GameResultDialog::GameTheme theme = GameResultDialog::Theme_Mole; // 默认
+    if (m_caps->resultTheme == "apple") theme = GameResultDialog::Theme_Apple;
+    else if (m_caps->resultTheme == "frog") theme = GameResultDialog::Theme_Frog;
+    else if (m_caps->resultTheme == "police") theme = GameResultDialog::Theme_Police;
+
+    GameResultDialog dlg(theme, this);
+    dlg.setRole(m_currentGame->resultRole());
+
+    dlg.setGameResult(score, win);
+    TRACE_EXEC(dlg, "GameResultDialog::exec");
+
+    GameResultDialog::ResultAction action = dlg.getSelectedAction();
+    if (action == GameResultDialog::Action_Replay) {
+        onStartGame();
+    }
+    else if (action == GameResultDialog::Action_NextLevel) {
+        m_currentGame->nextLevel();
+        onStartGame();
+    }
+    else {
+        onStopGameRound();
+    }
+}
+void GameWidget::onScoreChanged(int score) {
+
+}
+
+void GameWidget::closeEvent(QCloseEvent* event) {
+    // 关闭窗口时挂起当前这一局，等后台写完再退出
+    suspendCurrentGame();
+    SnapshotStore::instance().waitForIdle();
+    QWidget::closeEvent(event);
+}
+
+void GameWidget::onExitApp() {
+    close();
 }
\ No newline at end of file
@@ -1,98 +1,110 @@
-﻿#ifndef GAMEWIDGET_H
-#define GAMEWIDGET_H
-
-#include <QWidget>
-#include <QPushButton>
-#include <QLabel>
-#include "gamebase.h"
-#include "gamesettings.h"
-#include "imagebutton.h"
-#include "applegamesettings.h"
-#include "froggamesettings.h"
-
-// 引入具体游戏类
-#include "molegame.h"
-#include "policegame.h"
-#include "spacegame.h"
-#include "applegame.h"
-#include "froggame.h"
-
-class GameWidget : public QWidget {
-    Q_OBJECT
-
-public:
-    explicit GameWidget(QWidget* parent = nullptr);
-    ~GameWidget();
-
-protected:
-    void paintEvent(QPaintEvent* event) override;
-    void keyPressEvent(QKeyEvent* event) override;
-
-private slots:
-    // 菜单按钮槽
-    void onSelectMoleGame();
-    void onSelectPoliceGame();
-    void onSelectSpaceGame();
-    void onSelectAppleGame();
-    void onSelectFrogGame();
-    void onExitApp();
-    
-    // 游戏内按钮槽
-    void onStartGame();
-    void onPauseGame();
-    void onReturnToMenu(); // 返回主菜单
-    void onStopGameRound(); // 对应控制面板结束
-    void onShowSettings();
-
-    // 游戏反馈槽
-    void onGameFinished(int score, bool win);
-    void onScoreChanged(int score);
-
-private:
-    void setupMainMenu();  // 初始化主菜单界面
-    void setupGameUI();    // 初始化游戏内UI（按钮等）
-    void switchToGame(GameBase* game); // 切换到游戏模式
-    void updateButtons();  // 更新按钮状态
-
-    // 状态定义
-    enum AppState {
-        MainMenu, // 选择游戏界面
-        InGame    // 游戏中
-    };
-
-    AppState m_appState;
-    GameBase* m_currentGame; // 当前运行的游戏（多态）
-
-    // 具体游戏实例
-    MoleGame* m_moleGame;
-    PoliceGame* m_policeGame;
-    SpaceGame* m_spaceGame;
-    AppleGame* m_appleGame;
-    FrogGame* m_frogGame;
-    PoliceGameSettings* m_policeSettingsDialog;
-
-    // --- UI 元素 ---
-    // 1. 主菜单元素
-    QLabel* m_titleLabel;
-    QPushButton* m_btnMole;
-    QPushButton* m_btnPolice;
-    QPushButton* m_btnSpace;
-    QPushButton* m_btnApple;
-    QPushButton* m_btnFrog;
-    QPushButton* m_btnExit;
-
-    // 2. 游戏内通用元素 (HUD)
-    ImageButton* m_btnStart;
-    ImageButton* m_btnPause;
-    ImageButton* m_btnSettings;
-    ImageButton* m_btnEnd; // 返回主菜单
-    ImageButton* m_btnQuitGame;
-    
-    GameSettings* m_settingsDialog;
-    AppleGameSettings* m_appleSettingsDialog;
-    FrogGameSettings* m_frogSettingsDialog;
-
-    QTimer* m_renderTimer;
-};
-
+﻿#ifndef GAMEWIDGET_H
+#define GAMEWIDGET_H
+
+#include "gamecore_global.h"
+#include <QWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QHash>
+#include <QVector>
+#include "gamebase.h"
+#include "imagebutton.h"
+
+class GameGLView;
+class DifficultyController;
+
+class GAMECORE_EXPORT GameWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit GameWidget(QWidget* parent = nullptr);
+    ~GameWidget();
+
+    // 切换到 OpenGL 渲染（需在显示前调用）
+    void setOpenGLEnabled(bool enabled);
+    // 按玩家实时水平自动调节难度
+    void setAdaptiveDifficulty(bool enabled);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void childEvent(QChildEvent* event) override;
+    bool eventFilter(QObject* watched, QEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void closeEvent(QCloseEvent* event) override;
+
+private slots:
+    // 菜单按钮槽
+    void onExitApp();
+    
+    // 游戏内按钮槽
+    void onStartGame();
+    void onPauseGame();
+    void onReturnToMenu(); // 返回主菜单
+    void onStopGameRound(); // 对应控制面板结束
+    void onShowSettings();
+
+    // 游戏反馈槽
+    void onGameFinished(int score, bool win);
+    void onScoreChanged(int score);
+
+    void onGLFrameSwapped();
+
+private:
+    void setupMainMenu();  // 初始化主菜单界面
+    void setupGameUI();    // 初始化游戏内UI（按钮等）
+    void selectGame(const QString& id); // 菜单选中游戏
+    GameBase* gameFor(const QString& id); // 第一次选中时才创建
+    void switchToGame(GameBase* game, bool restored = false); // 切换到游戏模式；restored 表示已从快照恢复
+    void setMenuVisible(bool visible);
+    void applyHudLayout(const HudLayout& hud); // 按游戏的能力描述摆放 HUD 按钮
+    void suspendCurrentGame(); // 进行中的一局写入快照，已结束的删除旧快照
+    void updateButtons();  // 更新按钮状态
+    void renderFrame(QPainter& painter); // 绘制一帧（raster / OpenGL 共用）
+    void updateViewTransform();           // 按窗口尺寸计算逻辑画面的缩放与偏移
+    void syncChildGeometry(QWidget* child); // 子控件逻辑坐标 -> 实际坐标
+
+    // 状态定义
+    enum AppState {
+        MainMenu, // 选择游戏界面
+        InGame    // 游戏中
+    };
+
+    AppState m_appState;
+    GameBase* m_currentGame; // 当前运行的游戏（多态）
+    const GameCapabilities* m_caps; // 当前游戏的能力描述，切换游戏时读取
+
+    // 已创建的游戏，按 GameRegistry 的 id
+    QHash<QString, GameBase*> m_games;
+
+    // --- UI 元素 ---
+    // 1. 主菜单元素
+    QLabel* m_titleLabel;
+    QVector<QPushButton*> m_gameButtons; // 按注册表生成
+    QPushButton* m_btnExit;
+
+    // 2. 游戏内通用元素 (HUD)
+    ImageButton* m_btnStart;
+    ImageButton* m_btnPause;
+    ImageButton* m_btnSettings;
+    ImageButton* m_btnEnd; // 返回主菜单
+    ImageButton* m_btnQuitGame;
+
+    QTimer* m_renderTimer;
+    QTimer* m_autosaveTimer; // 游戏中定时挂起，崩溃后能从最近一次继续
+    GameGLView* m_glView; // 为空时使用 raster 绘制
+    DifficultyController* m_difficulty;
+
+    // 分辨率无关：逻辑画面 SCREEN_WIDTH x SCREEN_HEIGHT 等比缩放居中
+    struct ChildLayout {
+        bool known = false;
+        QRect logical; // 代码里设置的逻辑坐标
+        QRect applied; // 实际应用到控件上的坐标
+    };
+    QHash<QObject*, ChildLayout> m_childLayouts;
+    qreal m_viewScale;
+    QPoint m_viewOffset;
+    bool m_syncingLayout;
+};
+
 #endif // GAMEWIDGET_H
\ No newline at end of file
@@ -1,83 +1,87 @@
-﻿#include "imagebutton.h"
-
-ImageButton::ImageButton(const QString& normalPath,
-    const QString& hoverPath,
-    const QString& pressedPath,
-    QWidget* parent)
-    : QWidget(parent),
-    currentState(StateNormal),
-    isPressed(false) {
-
-    normalPixmap.load(normalPath);
-    hoverPixmap.load(hoverPath);
-    pressedPixmap.load(pressedPath);
-
-    setFixedSizeToPixmap();
-    setCursor(Qt::PointingHandCursor);
-
-    setFocusPolicy(Qt::NoFocus);
-}
-
-void ImageButton::loadImages(const QString& normalPath, const QString& hoverPath, const QString& pressedPath) {
-    normalPixmap.load(normalPath);
-    hoverPixmap.load(hoverPath);
-    pressedPixmap.load(pressedPath);
-
-    // 刷新当前显示
-    update();
-}
-
-void ImageButton::setFixedSizeToPixmap() {
-    if (!normalPixmap.isNull()) {
-        setFixedSize(normalPixmap.size());
-    }
-}
-
-void ImageButton::paintEvent(QPaintEvent* event) {
-    QPainter painter(this);
-
-    switch (currentState) {
-    case StateHover:
-        painter.drawPixmap(rect(), hoverPixmap);
-        break;
-    case StatePressed:
-        painter.drawPixmap(rect(), pressedPixmap);
-        break;
-    case StateNormal:
-    default:
-        painter.drawPixmap(rect(), normalPixmap);
-        break;
-    }
-}
-
-void ImageButton::mousePressEvent(QMouseEvent* event) {
-    if (event->button() == Qt::LeftButton) {
-        isPressed = true;
-        currentState = StatePressed;
-        update(); 
-    }
-}
-
-void ImageButton::mouseReleaseEvent(QMouseEvent* event) {
-    if (event->button() == Qt::LeftButton && isPressed) {
-        isPressed = false;
-        if (rect().contains(event->pos())) {
-            currentState = StateHover;
-            emit clicked(); 
-        }
-        else {
-            currentState = StateNormal;
-        }
-        update();
-    }
-}
-
-void ImageButton::enterEvent(QEvent* event) {
-    currentState = StateHover;
-    update();
-}
-
-void ImageButton::leaveEvent(QEvent* event) {
-    currentState = StateNormal;
-    update();
+﻿#include "imagebutton.h"
+#include "assetcache.h"
+
+ImageButton::ImageButton(const QString& normalPath,
+    const QString& hoverPath,
+    const QString& pressedPath,
+    QWidget* parent)
+    : QWidget(parent),
+    currentState(StateNormal),
+    isPressed(false) {
+
+    normalPixmap.load(normalPath);
+    hoverPixmap.load(hoverPath);
+    pressedPixmap.load(pressedPath);
+
+    setFixedSizeToPixmap();
+    setCursor(Qt::PointingHandCursor);
+
+    setFocusPolicy(Qt::NoFocus);
+}
+
+void ImageButton::loadImages(const QString& normalPath, const QString& hoverPath, const QString& pressedPath) {
+    normalPixmap.load(normalPath);
+    hoverPixmap.load(hoverPath);
+    pressedPixmap.load(pressedPath);
+
+    // 刷新当前显示
+    update();
+}
+
+void ImageButton::setFixedSizeToPixmap() {
+    if (!normalPixmap.isNull()) {
+        setFixedSize(normalPixmap.size());
+    }
+}
+
+void ImageButton::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+
+    const QPixmap* pixmap = &normalPixmap;
+    switch (currentState) {
+    case StateHover:
+        pixmap = &hoverPixmap;
+        break;
+    case StatePressed:
+        pixmap = &pressedPixmap;
+        break;
+    case StateNormal:
+    default:
+        break;
+    }
+
+    // 窗口缩放后按钮尺寸会变，取预缩放好的副本，避免每次重绘都重新采样
+    painter.drawPixmap(rect(), AssetCache::instance().fitted(*pixmap, size(), devicePixelRatioF()));
+}
+
+void ImageButton::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+        isPressed = true;
+        currentState = StatePressed;
+        update(); 
+    }
+}
+
+void ImageButton::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && isPressed) {
+        isPressed = false;
+        if (rect().contains(event->pos())) {
+            currentState = StateHover;
+            emit clicked(); 
+        }
+        else {
+            currentState = StateNormal;
+        }
+        update();
+    }
+}
+
+void ImageButton::enterEvent(QEvent* event) {
+    currentState = StateHover;
+    update();
+}
+
+void ImageButton::leaveEvent(QEvent* event) {
+    currentState = StateNormal;
+    update();
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+﻿#ifndef LETTERINDEX_H
+#define LETTERINDEX_H
+
+#include <QVector>
+#include <QKeyEvent>
+
+// 句柄 -> 非负的小整数，LetterIndex 按它记录每个实体在桶里的位置。
+// 默认取 EntityPool 句柄的槽位；直接用下标当句柄的（如地鼠洞）就是下标本身
+template <typename Handle>
+struct LetterIndexKey {
+    static int of(const Handle& handle) { return handle.slot; }
+};
+template <>
+struct LetterIndexKey<int> {
+    static int of(int index) { return index; }
+};
+
+// 按字母 A-Z 分成 26 个桶的活跃实体索引
+// 实体出现时 insert，被击中/失效时 remove，按键时直接取对应字母的桶，
+// 不必遍历全部实体比较字符串。桶内顺序不固定（删除时与末尾交换）。
+// 每个实体在桶里的位置另外记下，remove 是 O(1)；同一个键（槽位）同时只能有一个实体在索引里，
+// 所以实体要先 remove 再让槽位被复用。
+template <typename Handle>
+class LetterIndex {
+public:
+    static const int LetterCount = 26;
+
+    // 'A'-'Z' -> 0-25，其余返回 -1
+    static int bucketOf(char letter) {
+        return (letter >= 'A' && letter <= 'Z') ? letter - 'A' : -1;
+    }
+    // 按键 -> 0-25，与大小写、Shift 无关，不分配内存
+    static int bucketOf(const QKeyEvent* event) {
+        int key = event->key();
+        return (key >= Qt::Key_A && key <= Qt::Key_Z) ? key - Qt::Key_A : -1;
+    }
+
+    void clear() {
+        for (QVector<Handle>& bucket : m_buckets) bucket.clear(); // 保留容量
+        m_position.fill(-1);
+    }
+
+    void insert(char letter, const Handle& handle) {
+        int b = bucketOf(letter);
+        if (b < 0) return;
+        int key = LetterIndexKey<Handle>::of(handle);
+        while (m_position.size() <= key) m_position.append(-1);
+        m_position[key] = m_buckets[b].size();
+        m_buckets[b].append(handle);
+    }
+
+    bool remove(char letter, const Handle& handle) {
+        int b = bucketOf(letter);
+        if (b < 0) return false;
+        int key = LetterIndexKey<Handle>::of(handle);
+        if (key < 0 || key >= m_position.size()) return false;
+        QVector<Handle>& bucket = m_buckets[b];
+        int i = m_position[key];
+        if (i < 0 || i >= bucket.size() || !(bucket[i] == handle)) return false;
+
+        // 末尾的实体挪到空出来的位置
+        const Handle moved = bucket.last();
+        bucket[i] = moved;
+        m_position[LetterIndexKey<Handle>::of(moved)] = i;
+        bucket.removeLast();
+        m_position[key] = -1;
+        return true;
+    }
+
+    const QVector<Handle>& bucket(int b) const { return m_buckets[b]; }
+
+private:
+    QVector<Handle> m_buckets[LetterCount];
+    QVector<int> m_position; // 键 -> 在所在桶里的下标，不在索引里为 -1
+};
+
+#endif // LETTERINDEX_H
@@ -1,10 +1,59 @@
-﻿#include "gamewidget.h"
-#include <QtWidgets/QApplication>
-
-int main(int argc, char *argv[]) {
-    QApplication a(argc, argv);
-    GameWidget w;
-    w.show();
-
-    return a.exec();
+﻿#include "gamewidget.h"
+#include "gametrace.h"
+#include <QtWidgets/QApplication>
+#include <QCommandLineParser>
+#include <QResource>
+#include <QFile>
+#include <QMessageBox>
+
+// 注册并校验资源包。资源包用 QFile::map 内存映射后交给 Qt（按文件名注册在没有 mmap 的
+// Windows 上会整个读进内存），贴图和音效在第一次用到时才换入、解码
+static bool loadAssets() {
+#ifdef EXTERNAL_ASSETS
+    // 映射随 QFile 对象存在，资源要用到程序退出
+    static QFile packFile(QCoreApplication::applicationDirPath() + "/assets.rcc");
+    const uchar* pack = nullptr;
+    if (packFile.open(QIODevice::ReadOnly)) pack = packFile.map(0, packFile.size());
+    if (!pack || !QResource::registerResource(pack)) {
+        QMessageBox::critical(nullptr, QStringLiteral("错误"), QStringLiteral("无法加载资源包：") + packFile.fileName());
+        return false;
+    }
+#endif
+    QFile versionFile(":/assets.version");
+    QString version;
+    if (versionFile.open(QIODevice::ReadOnly)) {
+        version = QString::fromLatin1(versionFile.readAll()).trimmed();
+    }
+    if (version != ASSETS_VERSION) {
+        QMessageBox::critical(nullptr, QStringLiteral("错误"),
+            QStringLiteral("资源包版本不匹配：需要 %1，实际为 %2").arg(ASSETS_VERSION, version));
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    QApplication a(argc, argv);
+    if (!loadAssets()) return 1;
+
+    // 渲染后端：--renderer=opengl 或环境变量 GAME_RENDERER=opengl
+    QCommandLineParser parser;
+    QCommandLineOption rendererOpt("renderer", "raster or opengl", "backend",
+        QString::fromLocal8Bit(qgetenv("GAME_RENDERER")));
+    QCommandLineOption fullScreenOpt("fullscreen", "Show full screen (kiosk)");
+    parser.addOption(rendererOpt);
+    QCommandLineOption adaptiveOpt("adaptive", "Adjust difficulty to the player's live typing speed and accuracy");
+    parser.addOption(fullScreenOpt);
+    parser.addOption(adaptiveOpt);
+    parser.process(a);
+
+    GameWidget w;
+    w.setOpenGLEnabled(parser.value(rendererOpt).compare("opengl", Qt::CaseInsensitive) == 0);
+    w.setAdaptiveDifficulty(parser.isSet(adaptiveOpt));
+    if (parser.isSet(fullScreenOpt)) w.showFullScreen();
+    else w.show();
+
+    int ret = a.exec();
+    TRACE_FINISH();
+    return ret;
 }
\ No newline at end of file
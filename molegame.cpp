@@ -1,210 +1,536 @@
-﻿#include "molegame.h"
-#include <QRandomGenerator>
-#include <QDebug>
-
-const QPoint molePositions[8] = {
-    QPoint(30, 330), QPoint(230, 330), QPoint(430, 330), QPoint(640, 330),
-    QPoint(30, 140), QPoint(230, 140), QPoint(430, 140), QPoint(640, 140)
-};
-
-MoleGame::MoleGame(QObject* parent) : GameBase(parent) {
-    m_backgroundPixmap.load(":/img/background.bmp");
-    m_carrotPixmap.load(":/img/carrot.bmp");
-
-    m_hitSound = new QSoundEffect(this);
-    m_hitSound->setSource(QUrl::fromLocalFile(":/snd/hit.wav"));
-
-    m_missSound = new QSoundEffect(this);
-    m_missSound->setSource(QUrl::fromLocalFile(":/snd/miss.wav"));
-
-    m_backgroundMusic = new QSoundEffect(this);
-    m_backgroundMusic->setSource(QUrl::fromLocalFile(":/snd/background.wav"));
-    m_backgroundMusic->setLoopCount(QSoundEffect::Infinite);
-
-    m_gameTimer = new QTimer(this);
-    m_gameTimer->setInterval(1000);
-    connect(m_gameTimer, &QTimer::timeout, this, &MoleGame::onGameTimerTick);
-
-    m_spawnTimer = new QTimer(this);
-    connect(m_spawnTimer, &QTimer::timeout, this, &MoleGame::onSpawnTimerTick);
-
-    for (int i = 0; i < 8; ++i) {
-        Mole* mole = new Mole(this);
-        mole->setPos(molePositions[i]);
-        connect(mole, &Mole::hitSuccess, this, &MoleGame::onMoleHit);
-        connect(mole, &Mole::escaped, this, &MoleGame::onMoleEscaped);
-        m_moles.append(mole);
-    }
-}
-
-MoleGame::~MoleGame() {
-    qDeleteAll(m_moles);
-    m_moles.clear();
-}
-
-void MoleGame::updateSettings(const GameSettingsData& data) { m_settings = data; }
-void MoleGame::increaseDifficulty() {
-    m_settings.spawnIntervalMs = qMax(300, m_settings.spawnIntervalMs - 100);
-    m_settings.stayTimeMs = qMax(500, m_settings.stayTimeMs - 200);
-}
-
-void MoleGame::initGame() {
-    m_state = GameState::Ready;
-    m_score = 0;
-    m_lives = 5;
-    m_hitCount = 0;
-    m_totalSpawns = 0;
-    m_remainingTimeSec = m_settings.gameTimeSec;
-
-    m_gameTimer->stop();
-    m_spawnTimer->stop();
-    m_backgroundMusic->stop();
-
-    for (auto mole : m_moles) {
-        mole->hideMole();
-    }
-
-    emit scoreChanged(m_score);
-}
-
-void MoleGame::startGame() {
-    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
-        initGame();
-        m_state = GameState::Playing;
-
-        m_gameTimer->start();
-        m_backgroundMusic->play();
-
-        maintainMoleCount();
-
-        // 启动保底定时器，每500ms检查一次，防止场上地鼠意外变空
-        m_spawnTimer->start(500);
-    }
-}
-
-void MoleGame::pauseGame() {
-    if (m_state == GameState::Playing) {
-        m_state = GameState::Paused;
-        m_gameTimer->stop();
-        m_spawnTimer->stop();
-        m_backgroundMusic->stop();
-        for (auto mole : m_moles) mole->pause();
-    }
-    else if (m_state == GameState::Paused) {
-        m_state = GameState::Playing;
-        m_gameTimer->start();
-        m_spawnTimer->start(); // 恢复保底定时器
-        m_backgroundMusic->play();
-        for (auto mole : m_moles) mole->resume();
-    }
-}
-
-void MoleGame::stopGame() {
-    m_state = GameState::GameOver;
-    m_gameTimer->stop();
-    m_spawnTimer->stop();
-    m_backgroundMusic->stop();
-    for (auto mole : m_moles) mole->hideMole();
-}
-
-void MoleGame::draw(QPainter& painter) {
-    painter.drawPixmap(0, 0, m_backgroundPixmap);
-    for (auto mole : m_moles) {
-        mole->draw(painter);
-    }
-    for (int i = 0; i < m_lives; ++i) {
-        painter.drawPixmap(140 + i * 35, 540, 30, 77, m_carrotPixmap);
-    }
-
-    painter.setPen(Qt::black);
-    painter.setFont(QFont("Arial", 12));
-
-    painter.drawText(603, 540, QString::number(m_settings.gameTimeSec / 60));
-    painter.drawText(720, 540, QString("%1s").arg(m_remainingTimeSec));
-
-    double accuracy = (m_totalSpawns == 0) ? 0.0 : (double)m_hitCount / m_totalSpawns * 100.0;
-    painter.drawText(610, 570, QString("%1%").arg((int)accuracy));
-    painter.drawText(730, 570, QString::number(m_hitCount));
-}
-
-void MoleGame::handleKeyPress(QKeyEvent* event) {
-    if (m_state != GameState::Playing || event->isAutoRepeat()) return;
-
-    QString key = event->text().toUpper();
-    if (key.isEmpty()) return;
-
-    for (auto mole : m_moles) {
-        // 只有 Visible 状态的才能被打
-        if (mole->isActive() && mole->getLetter() == key) {
-            mole->hitByUser();
-            break;
-        }
-    }
-}
-
-void MoleGame::maintainMoleCount() {
-    if (m_state != GameState::Playing) return;
-
-    int activeCount = 0;
-    QVector<int> freeIndices;
-
-    for (int i = 0; i < m_moles.size(); ++i) {
-        if (m_moles[i]->isActive()) {
-            activeCount++;
-        }
-        else if (m_moles[i]->isFree()) {
-            freeIndices.append(i);
-        }
-    }
-
-    // 目标保持 3 只
-    int needed = 3 - activeCount;
-    while (needed > 0 && !freeIndices.isEmpty()) {
-        int randIdx = QRandomGenerator::global()->bounded(freeIndices.size());
-        int moleIdx = freeIndices[randIdx];
-
-        char letter = 'A' + QRandomGenerator::global()->bounded(26);
-        m_moles[moleIdx]->showMole(QString(letter), m_settings.stayTimeMs);
-        m_totalSpawns++;
-
-        freeIndices.removeAt(randIdx);
-        needed--;
-    }
-}
-
-void MoleGame::onGameTimerTick() {
-    m_remainingTimeSec--;
-    if (m_remainingTimeSec <= 0) {
-        stopGame();
-        emit gameFinished(m_hitCount * 10, true);
-    }
-}
-
-void MoleGame::onSpawnTimerTick() {
-    // 保底机制：如果场上数量意外不对，补充地鼠
-    maintainMoleCount();
-}
-
-void MoleGame::onMoleHit() {
-    m_hitCount++;
-    m_score += 10;
-    m_hitSound->play();
-    emit scoreChanged(m_score);
-
-    // 打掉一只，立马补一只
-    maintainMoleCount();
-}
-
-void MoleGame::onMoleEscaped() {
-    m_lives--;
-
-
-    if (m_lives <= 0) {
-        stopGame();
-        emit gameFinished(m_hitCount * 10, false);
-    }
-    else {
-        // 跑掉一只，立马补一只
-        maintainMoleCount();
-    }
-}
\ No newline at end of file
+﻿#include "molegame.h"
+#include "gametrace.h"
+#include "assetcache.h"
+#include "audiomixer.h"
+#include "contentgenerator.h"
+#include <QDebug>
+
+const QPoint molePositions[8] = {
+    QPoint(30, 330), QPoint(230, 330), QPoint(430, 330), QPoint(640, 330),
+    QPoint(30, 140), QPoint(230, 140), QPoint(430, 140), QPoint(640, 140)
+};
+
+MoleGame::MoleGame(QObject* parent) : GameBase(parent), m_level(1) {
+    m_backgroundPixmap.load(":/img/background.bmp");
+    m_carrotPixmap.load(":/img/carrot.bmp");
+
+    m_moleNormal.load(":/img/mole_normal.bmp");
+    m_moleHit.load(":/img/mole_hit.bmp");
+    m_moleEscape1.load(":/img/mole_hide_1.bmp");
+    if (m_moleEscape1.isNull()) m_moleEscape1.load(":/img/mole_hide.bmp");
+    m_moleEscape2.load(":/img/mole_hide_2.bmp");
+    if (m_moleEscape2.isNull()) m_moleEscape2.load(":/img/mole_hide.bmp");
+
+    m_hitSound = AudioMixer::instance().load(":/snd/hit.wav");
+    m_missSound = AudioMixer::instance().load(":/snd/miss.wav");
+    m_escapeSound = AudioMixer::instance().load(":/snd/mouse_away.wav");
+
+    m_tickTimer = new QTimer(this);
+    m_tickTimer->setSingleShot(true);
+    m_tickTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_tickTimer, &QTimer::timeout, this, &MoleGame::onSchedulerTick);
+
+    m_pausedAt = -1;
+    m_pausedTotal = 0;
+    m_clock.start();
+
+    setupBoard(m_settings.holeCount);
+}
+
+MoleGame::~MoleGame() {}
+
+void MoleGame::setupBoard(int holeCount) {
+    holeCount = qBound(1, holeCount, MaxHoles);
+    m_moles.fill(MoleSlot(), holeCount);
+    m_holePositions.clear();
+    m_activeTarget = qMax(3, holeCount * 3 / 8); // 8 个洞时保持 3 只
+
+    QSize baseSize = m_moleNormal.isNull() ? QSize(180, 180) : m_moleNormal.size();
+    if (holeCount == 8) {
+        // 与背景图上的 8 个洞对齐
+        for (const QPoint& pos : molePositions) m_holePositions.append(pos);
+        m_moleScale = 1.0;
+    }
+    else {
+        // 洞多时在草地区域内排成网格，地鼠按格子缩小
+        const QRect board(20, 40, SCREEN_WIDTH - 40, 480);
+        int cols = qMin(holeCount, holeCount <= 16 ? 4 : 8);
+        int rows = (holeCount + cols - 1) / cols;
+        qreal cellW = board.width() / (qreal)cols;
+        qreal cellH = board.height() / (qreal)rows;
+        m_moleScale = qMin(1.0, qMin(cellW / baseSize.width(), cellH / baseSize.height()));
+        for (int i = 0; i < holeCount; ++i) {
+            int col = i % cols;
+            int row = i / cols;
+            m_holePositions.append(QPoint(qRound(board.x() + col * cellW + (cellW - baseSize.width() * m_moleScale) / 2),
+                qRound(board.y() + row * cellH + (cellH - baseSize.height() * m_moleScale) / 2)));
+        }
+    }
+
+    m_moleSize = baseSize * m_moleScale;
+    m_letterFont = QFont("Arial", 20, QFont::Bold);
+    m_letterFont.setPointSizeF(20 * m_moleScale);
+    m_countdownFont = QFont("Arial", 14, QFont::Bold);
+    m_countdownFont.setPointSizeF(14 * m_moleScale);
+}
+
+// 洞数在下一次 initGame 时生效，避免打乱进行中的调度
+void MoleGame::updateSettings(const GameSettingsData& data) { m_settings = data; m_level = 1; }
+void MoleGame::increaseDifficulty() {
+    m_level++;
+    m_settings.spawnIntervalMs = qMax(300, m_settings.spawnIntervalMs - 100);
+    m_settings.stayTimeMs = qMax(500, m_settings.stayTimeMs - 200);
+}
+
+const GameCapabilities& MoleGame::capabilities() const {
+    // 控制面板在地鼠洞下方偏右
+    static const GameCapabilities caps = [] {
+        GameCapabilities c;
+        c.resultTheme = QStringLiteral("mole");
+        c.hud.end.pos = QPoint(450, 480);
+        c.hud.pause.pos = QPoint(400, 510);
+        c.hud.start.pos = QPoint(490, 530);
+        c.hud.settings.pos = QPoint(440, 550);
+        c.hud.quit.pos = QPoint(40, 550);
+        c.supportsSnapshots = true;
+        return c;
+    }();
+    return caps;
+}
+
+GameBase::SettingsResult MoleGame::execSettings(QWidget* parent) {
+    if (!m_settingsDialog) m_settingsDialog = new GameSettings(parent);
+
+    GameSettingsData oldSettings = m_settingsDialog->getSettings();
+    if (TRACE_EXEC(*m_settingsDialog, "GameSettings::exec") != QDialog::Accepted) return SettingsRejected;
+
+    m_pendingSettings = m_settingsDialog->getSettings();
+    bool changed = (oldSettings.gameTimeSec != m_pendingSettings.gameTimeSec) ||
+        (oldSettings.spawnIntervalMs != m_pendingSettings.spawnIntervalMs) ||
+        (oldSettings.stayTimeMs != m_pendingSettings.stayTimeMs) ||
+        (oldSettings.holeCount != m_pendingSettings.holeCount);
+    return changed ? SettingsChanged : SettingsUnchanged;
+}
+
+void MoleGame::initGame() {
+    m_state = GameState::Ready;
+    m_score = 0;
+    m_lives = 5;
+    m_hitCount = 0;
+    m_totalSpawns = 0;
+    m_lastLetter = 0;
+    m_remainingTimeSec = m_settings.gameTimeSec;
+
+    clearSchedule();
+    AudioMixer::instance().stopMusic();
+
+    if (m_moles.size() != m_settings.holeCount) {
+        m_letterIndex.clear();
+        setupBoard(m_settings.holeCount);
+    }
+    for (int i = 0; i < m_moles.size(); ++i) {
+        hideMole(i);
+    }
+
+    // 游戏时钟从零开始
+    m_clock.restart();
+    m_pausedAt = -1;
+    m_pausedTotal = 0;
+
+    emit scoreChanged(m_score);
+}
+
+void MoleGame::startGame() {
+    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
+        initGame();
+        m_state = GameState::Playing;
+        beginSession();
+
+        const qint64 now = gameTimeMs();
+        scheduleAt(now + 1000, GameSecond);
+        AudioMixer::instance().playMusic(":/snd/background.wav");
+
+        maintainMoleCount();
+
+        // 保底检查，每500ms一次，防止场上地鼠意外变空
+        scheduleAt(now + 500, SpawnCheck);
+        armTickTimer();
+    }
+}
+
+void MoleGame::pauseGame() {
+    if (m_state == GameState::Playing) {
+        m_state = GameState::Paused;
+        pauseSession();
+        m_pausedAt = m_clock.elapsed(); // 冻结游戏时钟，所有到期时间随之顺延
+        m_tickTimer->stop();
+        AudioMixer::instance().stopMusic();
+    }
+    else if (m_state == GameState::Paused) {
+        m_state = GameState::Playing;
+        resumeSession();
+        m_pausedTotal += m_clock.elapsed() - m_pausedAt;
+        m_pausedAt = -1;
+        AudioMixer::instance().playMusic(":/snd/background.wav");
+        armTickTimer();
+    }
+}
+
+void MoleGame::stopGame() {
+    m_state = GameState::GameOver;
+    clearSchedule();
+    AudioMixer::instance().stopMusic();
+    for (int i = 0; i < m_moles.size(); ++i) hideMole(i);
+}
+
+void MoleGame::saveState(QDataStream& out) const {
+    // 时刻都按游戏时钟保存，恢复时让时钟从 now 接着走
+    const qint64 now = gameTimeMs();
+    out << m_settings.gameTimeSec << m_settings.spawnIntervalMs << m_settings.stayTimeMs << m_settings.holeCount
+        << m_level << m_lives << m_remainingTimeSec << m_hitCount << m_totalSpawns << qint8(m_lastLetter) << now;
+
+    out << qint32(m_moles.size());
+    for (const MoleSlot& mole : m_moles) {
+        out << quint8(mole.state) << qint8(mole.letter) << mole.serial << mole.shownAt << mole.stayTimeMs;
+    }
+
+    // 优先队列不能遍历，复制一份逐个弹出（已过期的事件一并保存，分发时照常忽略）
+    auto events = m_events;
+    out << qint32(events.size());
+    while (!events.empty()) {
+        const ScheduledEvent& e = events.top();
+        out << e.due << quint8(e.kind) << e.mole << e.serial;
+        events.pop();
+    }
+}
+
+bool MoleGame::restoreState(QDataStream& in) {
+    // 设置和关卡先读到局部变量，全部校验通过后才生效；失败时 initGame 按原设置复位
+    GameSettingsData settings;
+    int level;
+    qint8 lastLetter;
+    qint64 now;
+    qint32 holeCount;
+    in >> settings.gameTimeSec >> settings.spawnIntervalMs >> settings.stayTimeMs >> settings.holeCount
+        >> level >> m_lives >> m_remainingTimeSec >> m_hitCount >> m_totalSpawns >> lastLetter >> now >> holeCount;
+    if (in.status() != QDataStream::Ok || level < 1) return false;
+    if (settings.gameTimeSec <= 0 || settings.spawnIntervalMs <= 0 || settings.stayTimeMs <= 0) return false;
+    if (settings.holeCount < 1 || settings.holeCount > MaxHoles || holeCount < 1 || holeCount > MaxHoles) return false;
+    m_lastLetter = lastLetter;
+
+    // 洞数按这一局的棋盘来（局中改过的设置要到下一局才生效）
+    if (m_moles.size() != holeCount) {
+        m_letterIndex.clear();
+        setupBoard(holeCount);
+    }
+
+    for (int i = 0; i < m_moles.size(); ++i) {
+        quint8 state;
+        qint8 letter;
+        MoleSlot& mole = m_moles[i];
+        in >> state >> letter >> mole.serial >> mole.shownAt >> mole.stayTimeMs;
+        if (in.status() != QDataStream::Ok || state > Escaping_2) return false;
+        mole.state = MoleState(state);
+        mole.letter = letter;
+        if (mole.state == Visible) {
+            if (LetterIndex<int>::bucketOf(mole.letter) < 0) return false;
+            m_letterIndex.insert(mole.letter, i);
+        }
+    }
+
+    qint32 eventCount;
+    in >> eventCount;
+    clearSchedule();
+    for (int i = 0; i < eventCount; ++i) {
+        ScheduledEvent e;
+        quint8 kind;
+        in >> e.due >> kind >> e.mole >> e.serial;
+        if (in.status() != QDataStream::Ok || kind > SpawnCheck || e.mole >= m_moles.size()) return false;
+        if ((kind == MoleStayExpired || kind == MoleAnimation) && e.mole < 0) return false;
+        e.kind = EventKind(kind);
+        m_events.push(e);
+    }
+
+    m_settings = settings;
+    m_level = level;
+
+    // 以暂停状态恢复：时钟读数冻结在 now，继续时从这里顺延
+    m_state = GameState::Paused;
+    m_clock.restart();
+    m_pausedAt = 0;
+    m_pausedTotal = -now;
+    m_tickTimer->stop();
+    AudioMixer::instance().stopMusic();
+    return true;
+}
+
+qint64 MoleGame::gameTimeMs() const {
+    return (m_pausedAt >= 0 ? m_pausedAt : m_clock.elapsed()) - m_pausedTotal;
+}
+
+void MoleGame::scheduleAt(qint64 due, EventKind kind, int mole) {
+    ScheduledEvent event;
+    event.due = due;
+    event.kind = kind;
+    event.mole = mole;
+    event.serial = mole >= 0 ? m_moles[mole].serial : 0;
+    m_events.push(event);
+}
+
+void MoleGame::clearSchedule() {
+    m_tickTimer->stop();
+    m_events = decltype(m_events)();
+}
+
+void MoleGame::armTickTimer() {
+    if (m_state != GameState::Playing || m_events.empty()) {
+        m_tickTimer->stop();
+        return;
+    }
+    m_tickTimer->start((int)qMax<qint64>(0, m_events.top().due - gameTimeMs()));
+}
+
+void MoleGame::onSchedulerTick() {
+    TRACE_SCOPE("MoleGame::onSchedulerTick");
+    const qint64 now = gameTimeMs();
+    // 事件处理可能结束游戏（清空队列），每次都重新检查
+    while (m_state == GameState::Playing && !m_events.empty() && m_events.top().due <= now) {
+        ScheduledEvent event = m_events.top();
+        m_events.pop();
+        dispatch(event);
+    }
+    armTickTimer();
+}
+
+void MoleGame::dispatch(const ScheduledEvent& event) {
+    switch (event.kind) {
+    case MoleStayExpired: {
+        const MoleSlot& mole = m_moles[event.mole];
+        if (mole.state != Visible || mole.serial != event.serial) break; // 已被打中
+        // 每帧显示 150ms；先排好动画再处理逃跑，逃跑可能直接结束游戏
+        scheduleAt(event.due + 150, MoleAnimation, event.mole);
+        escapeMole(event.mole);
+        break;
+    }
+    case MoleAnimation: {
+        MoleSlot& mole = m_moles[event.mole];
+        if (mole.serial != event.serial) break;
+        if (mole.state == Escaping_1) {
+            mole.state = Escaping_2;
+            scheduleAt(event.due + 150, MoleAnimation, event.mole);
+        }
+        else {
+            hideMole(event.mole); // 被打中动画结束，或逃跑第二帧结束
+        }
+        break;
+    }
+    case GameSecond:
+        // 按上一次的到期时间排下一秒，不会累积误差
+        scheduleAt(event.due + 1000, GameSecond);
+        onGameSecond();
+        break;
+    case SpawnCheck:
+        scheduleAt(event.due + scaledInterval(500), SpawnCheck);
+        maintainMoleCount();
+        break;
+    }
+}
+
+void MoleGame::draw(QPainter& painter) {
+    TRACE_SCOPE("MoleGame::draw");
+    AssetCache& assets = AssetCache::instance();
+    painter.drawPixmap(0, 0, assets.scaled(m_backgroundPixmap));
+    const qint64 now = gameTimeMs();
+    for (int i = 0; i < m_moles.size(); ++i) {
+        if (m_moles[i].state != Hidden) drawMole(painter, i, now);
+    }
+    for (int i = 0; i < m_lives; ++i) {
+        painter.drawPixmap(140 + i * 35, 540, 30, 77, assets.scaled(m_carrotPixmap, QSize(30, 77)));
+    }
+
+    painter.setPen(Qt::black);
+    painter.setFont(QFont("Arial", 12));
+
+    painter.drawText(603, 540, QString::number(m_settings.gameTimeSec / 60));
+    painter.drawText(720, 540, QString("%1s").arg(m_remainingTimeSec));
+
+    double accuracy = (m_totalSpawns == 0) ? 0.0 : (double)m_hitCount / m_totalSpawns * 100.0;
+    painter.drawText(610, 570, QString("%1%").arg((int)accuracy));
+    painter.drawText(730, 570, QString::number(m_hitCount));
+}
+
+void MoleGame::handleKeyPress(QKeyEvent* event) {
+    if (m_state != GameState::Playing || event->isAutoRepeat()) return;
+
+    int bucket = LetterIndex<int>::bucketOf(event);
+    if (bucket < 0) return;
+
+    // 索引里只有 Visible 状态的地鼠，取任意一只
+    const QVector<int>& candidates = m_letterIndex.bucket(bucket);
+    const QChar actual('A' + bucket);
+    QChar expected = candidates.isEmpty() ? QChar() : actual;
+    if (expected.isNull()) {
+        // 按错时记在最快要逃跑的那只地鼠上，那才是玩家该按的键
+        const qint64 now = gameTimeMs();
+        qint64 soonest = 0;
+        for (const MoleSlot& mole : m_moles) {
+            if (mole.state != Visible) continue;
+            const qint64 left = mole.shownAt + mole.stayTimeMs - now;
+            if (expected.isNull() || left < soonest) {
+                expected = QChar(mole.letter);
+                soonest = left;
+            }
+        }
+    }
+    reportKeystroke(expected, actual);
+    if (!candidates.isEmpty()) {
+        hitMole(candidates.first());
+    }
+    armTickTimer();
+}
+
+void MoleGame::maintainMoleCount() {
+    if (m_state != GameState::Playing) return;
+
+    int activeCount = 0;
+    QVector<int> freeIndices;
+
+    freeIndices.reserve(m_moles.size());
+
+    for (int i = 0; i < m_moles.size(); ++i) {
+        // 只有 Visible 才算"在场活跃"，被打中或逃跑中都不算；只有 Hidden 才能生成新地鼠
+        if (m_moles[i].state == Visible) {
+            activeCount++;
+        }
+        else if (m_moles[i].state == Hidden) {
+            freeIndices.append(i);
+        }
+    }
+
+    int needed = m_activeTarget - activeCount;
+    while (needed > 0 && !freeIndices.isEmpty()) {
+        int randIdx = m_rng.bounded(freeIndices.size());
+        int moleIdx = freeIndices[randIdx];
+
+        char letter = ContentGenerator::instance().letter(m_rng, m_lastLetter);
+        m_lastLetter = letter;
+        const qint64 now = gameTimeMs();
+        showMole(moleIdx, letter, now);
+        scheduleAt(now + m_moles[moleIdx].stayTimeMs, MoleStayExpired, moleIdx);
+        m_totalSpawns++;
+
+        freeIndices.removeAt(randIdx);
+        needed--;
+    }
+}
+
+void MoleGame::onGameSecond() {
+    m_remainingTimeSec--;
+    if (m_remainingTimeSec <= 0) {
+        stopGame();
+        emit gameFinished(m_hitCount * 10, true);
+    }
+}
+
+void MoleGame::onMoleHit() {
+    m_hitCount++;
+    m_score += 10;
+    AudioMixer::instance().play(m_hitSound);
+    emit scoreChanged(m_score);
+
+    // 打掉一只，立马补一只
+    maintainMoleCount();
+}
+
+void MoleGame::onMoleEscaped() {
+    m_lives--;
+
+
+    if (m_lives <= 0) {
+        stopGame();
+        emit gameFinished(m_hitCount * 10, false);
+    }
+    else {
+        // 跑掉一只，立马补一只
+        maintainMoleCount();
+    }
+}
+
+void MoleGame::showMole(int index, char letter, qint64 now) {
+    MoleSlot& mole = m_moles[index];
+    if (mole.state != Hidden) return;
+
+    mole.state = Visible;
+    mole.letter = letter;
+    mole.serial++;
+    mole.shownAt = now;
+    mole.stayTimeMs = scaledDuration(m_settings.stayTimeMs);
+    m_letterIndex.insert(letter, index);
+}
+
+void MoleGame::hitMole(int index) {
+    MoleSlot& mole = m_moles[index];
+    if (mole.state != Visible) return;
+
+    m_letterIndex.remove(mole.letter, index);
+    mole.state = Hit;
+    // 被打中的画面保留 500ms
+    scheduleAt(gameTimeMs() + 500, MoleAnimation, index);
+    onMoleHit();
+}
+
+void MoleGame::escapeMole(int index) {
+    MoleSlot& mole = m_moles[index];
+    if (mole.state != Visible) return;
+
+    // 时间到，开始逃跑
+    m_letterIndex.remove(mole.letter, index);
+    mole.state = Escaping_1;
+    AudioMixer::instance().play(m_escapeSound); // 播放逃跑音效
+    onMoleEscaped(); // 扣分并补充新地鼠
+}
+
+void MoleGame::hideMole(int index) {
+    MoleSlot& mole = m_moles[index];
+    if (mole.state == Visible) m_letterIndex.remove(mole.letter, index);
+    mole.state = Hidden;
+    mole.letter = 0;
+}
+
+void MoleGame::drawMole(QPainter& painter, int index, qint64 now) {
+    const MoleSlot& mole = m_moles[index];
+    const QPoint& pos = m_holePositions[index];
+    AssetCache& assets = AssetCache::instance();
+
+    switch (mole.state) {
+    case Visible: {
+        painter.drawPixmap(pos, assets.scaled(m_moleNormal, m_moleSize));
+
+        QRectF letterRect(pos.x() + 70 * m_moleScale, pos.y() + 20 * m_moleScale, 40 * m_moleScale, 30 * m_moleScale);
+        painter.setFont(m_letterFont);
+        painter.setPen(Qt::black);
+        painter.drawText(letterRect, Qt::AlignCenter, QString(QChar(mole.letter)));
+
+        // 整秒倒计时：出场时为 stayTime/1000，每过一秒减一
+        int remainingDisplayTime = mole.stayTimeMs / 1000 - (int)((now - mole.shownAt) / 1000);
+        if (remainingDisplayTime > 0) {
+            QRectF countdownRect(pos.x() + 70 * m_moleScale, pos.y() + 110 * m_moleScale, 20 * m_moleScale, 20 * m_moleScale);
+            painter.setFont(m_countdownFont);
+            painter.setPen(Qt::white);
+            painter.drawText(countdownRect, Qt::AlignCenter, QString::number(remainingDisplayTime));
+        }
+        break;
+    }
+    case Hit:
+        painter.drawPixmap(pos, assets.scaled(m_moleHit, m_moleSize));
+        break;
+    case Escaping_1:
+        painter.drawPixmap(pos, assets.scaled(m_moleEscape1, m_moleSize));
+        break;
+    case Escaping_2:
+        painter.drawPixmap(pos, assets.scaled(m_moleEscape2, m_moleSize));
+        break;
+    default:
+        break;
+    }
+}
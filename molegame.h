@@ -1,57 +1,142 @@
-﻿#ifndef MOLEGAME_H
-#define MOLEGAME_H
-
-#include "gamebase.h"
-#include "mole.h"
-#include "gamesettings.h"
-#include <QVector>
-#include <QLabel>
-#include <QTimer>
-#include <QtMultimedia/QSoundEffect>
-
-class MoleGame : public GameBase {
-    Q_OBJECT
-
-public:
-    explicit MoleGame(QObject* parent = nullptr);
-    ~MoleGame();
-
-    void initGame() override;
-    void startGame() override;
-    void pauseGame() override;
-    void stopGame() override;
-    void draw(QPainter& painter) override;
-    void handleKeyPress(QKeyEvent* event) override;
-
-    void updateSettings(const GameSettingsData& data);
-    void increaseDifficulty();
-
-private slots:
-    void onGameTimerTick();
-    void onSpawnTimerTick();
-    void onMoleHit();
-    void onMoleEscaped();
-
-private:
-    void maintainMoleCount(); // 维持场上地鼠数量
-    void checkGameOver();
-
-    QPixmap m_backgroundPixmap;
-    QPixmap m_carrotPixmap;
-    QVector<Mole*> m_moles;
-
-    QSoundEffect* m_hitSound;
-    QSoundEffect* m_missSound;
-    QSoundEffect* m_backgroundMusic;
-
-    QTimer* m_gameTimer;
-    QTimer* m_spawnTimer;
-
-    GameSettingsData m_settings;
-    int m_lives;
-    int m_remainingTimeSec;
-    int m_hitCount;
-    int m_totalSpawns;
-};
-
+﻿#ifndef MOLEGAME_H
+#define MOLEGAME_H
+
+#include "gamecore_global.h"
+#include "gamebase.h"
+#include "gamesettings.h"
+#include "letterindex.h"
+#include <QVector>
+#include <QLabel>
+#include <QTimer>
+#include <QPixmap>
+#include <QFont>
+#include <QElapsedTimer>
+#include <queue>
+#include <vector>
+
+class GAMECORE_EXPORT MoleGame : public GameBase {
+    Q_OBJECT
+
+public:
+    explicit MoleGame(QObject* parent = nullptr);
+    ~MoleGame();
+
+    void initGame() override;
+    void startGame() override;
+    void pauseGame() override;
+    void stopGame() override;
+    void draw(QPainter& painter) override;
+    void handleKeyPress(QKeyEvent* event) override;
+    QString gameId() const override { return QStringLiteral("mole"); }
+    int difficulty() const override { return m_level; }
+    const GameCapabilities& capabilities() const override;
+    SettingsResult execSettings(QWidget* parent) override;
+    void applySettings() override { updateSettings(m_pendingSettings); }
+    void nextLevel() override { increaseDifficulty(); }
+
+    void updateSettings(const GameSettingsData& data);
+    void increaseDifficulty();
+
+    static const int MaxHoles = 64;
+
+protected:
+    void saveState(QDataStream& out) const override;
+    bool restoreState(QDataStream& in) override;
+
+private slots:
+    void onSchedulerTick();
+
+private:
+    friend class BenchAccess; // 基准测试直接构造内部状态
+
+    enum MoleState : quint8 {
+        Hidden,
+        Visible,
+        Hit,
+        Escaping_1, // 逃跑动画帧1
+        Escaping_2  // 逃跑动画帧2
+    };
+
+    // 每个洞一条紧凑记录，状态切换全部由调度器在 MoleGame 里完成
+    struct MoleSlot {
+        MoleState state = Hidden;
+        char letter = 0;     // 'A'-'Z'，Hidden 时为 0
+        int serial = 0;      // 每次出场加一，用来识别过期的调度事件
+        qint64 shownAt = 0;  // 出场时刻（游戏时钟）
+        int stayTimeMs = 0;
+    };
+
+    void setupBoard(int holeCount); // 按洞数排布位置并缩放贴图
+    void showMole(int index, char letter, qint64 now);
+    void hitMole(int index);
+    void escapeMole(int index);
+    void hideMole(int index);
+    void drawMole(QPainter& painter, int index, qint64 now);
+
+    void maintainMoleCount(); // 维持场上地鼠数量
+    void checkGameOver();
+    void onMoleHit();
+    void onMoleEscaped();
+    void onGameSecond();
+
+    // 调度器：地鼠状态切换、倒计时和补充检查都按游戏时钟排进一个优先队列，
+    // 由唯一的 m_tickTimer 在最早的到期时刻触发；暂停只需冻结时钟、停掉这一个定时器
+    enum EventKind {
+        MoleStayExpired, // 停留时间到，开始逃跑
+        MoleAnimation,   // 被打中/逃跑动画的下一帧
+        GameSecond,      // 游戏倒计时一秒
+        SpawnCheck       // 保底补充地鼠
+    };
+    struct ScheduledEvent {
+        qint64 due;  // 游戏时钟毫秒
+        EventKind kind;
+        int mole;    // 地鼠下标，非地鼠事件为 -1
+        int serial;  // 安排时地鼠的出场序号，不一致说明事件已过期
+        bool operator>(const ScheduledEvent& o) const { return due > o.due; }
+    };
+    void scheduleAt(qint64 due, EventKind kind, int mole = -1);
+    void dispatch(const ScheduledEvent& event);
+    void armTickTimer();
+    void clearSchedule();
+    qint64 gameTimeMs() const;
+
+    QPixmap m_backgroundPixmap;
+    QPixmap m_carrotPixmap;
+    // 地鼠数据与位置分开存放，绘制和按键查找只遍历需要的部分
+    QVector<MoleSlot> m_moles;
+    QVector<QPoint> m_holePositions;
+    LetterIndex<int> m_letterIndex; // 字母 -> 露头(Visible)的洞下标
+    int m_activeTarget; // 场上保持的活跃地鼠数
+
+    // 所有洞共用的贴图和字体
+    QPixmap m_moleNormal;
+    QPixmap m_moleHit;
+    QPixmap m_moleEscape1;
+    QPixmap m_moleEscape2;
+    QSize m_moleSize;   // 绘制尺寸（逻辑像素），洞多时缩小
+    qreal m_moleScale;
+    QFont m_letterFont;
+    QFont m_countdownFont;
+
+    int m_hitSound;     // AudioMixer 音效 id
+    int m_missSound;
+    int m_escapeSound;
+
+    std::priority_queue<ScheduledEvent, std::vector<ScheduledEvent>, std::greater<ScheduledEvent>> m_events;
+    QTimer* m_tickTimer;
+    QElapsedTimer m_clock;
+    qint64 m_pausedAt;    // 暂停时的时钟读数，-1 表示未暂停
+    qint64 m_pausedTotal; // 累计暂停时长
+
+    GameSettingsData m_settings;
+    GameSettings* m_settingsDialog = nullptr; // 第一次打开设置时创建
+    GameSettingsData m_pendingSettings;
+    int m_level; // 结算界面“下一关”的次数 + 1
+    int m_lives;
+    int m_remainingTimeSec;
+    int m_hitCount;
+    int m_totalSpawns;
+    char m_lastLetter; // 上一个生成的字母，用于字母组合加权
+};
+
 #endif // MOLEGAME_H
\ No newline at end of file
@@ -0,0 +1,133 @@
+﻿#include "passageindex.h"
+
+namespace {
+
+bool isClosing(QChar c) {
+    const ushort u = c.unicode();
+    return u == '"' || u == '\'' || u == ')' || u == 0x201D || u == 0x2019 || u == 0x300D || u == 0xFF09;
+}
+
+} // namespace
+
+void PassageIndex::clear() {
+    m_articles.clear();
+    m_passages.clear();
+    m_firstPassage.clear();
+    for (QVector<int>& bucket : m_buckets) bucket.clear();
+}
+
+void PassageIndex::replaceArticle(int article, const QString& text) {
+    if (article < 0 || article >= m_articles.size()) return;
+    // 段落按文章连续存放、各档位存的是段落编号，原地改动不如整体重建简单；
+    // 只在文件改过之后发生，代价与重新载入一次相同
+    QStringList articles = m_articles;
+    articles[article] = text;
+    clear();
+    for (const QString& a : articles) addArticle(a);
+}
+
+bool PassageIndex::isSentenceEnd(const QString& text, int i) {
+    const ushort u = text.at(i).unicode();
+    // 中文句号等后面不需要空格
+    if (u == 0x3002 || u == 0xFF01 || u == 0xFF1F) return true;
+    if (u != '.' && u != '!' && u != '?') return false;
+    return i + 1 == text.size() || text.at(i + 1).isSpace() || isClosing(text.at(i + 1));
+}
+
+int PassageIndex::addArticle(const QString& text) {
+    const int article = m_articles.size();
+    m_articles.append(text);
+    m_firstPassage.append(-1);
+
+    const int n = text.size();
+    int pos = 0;
+    while (pos < n) {
+        while (pos < n && text.at(pos).isSpace()) ++pos;
+        if (pos >= n) break;
+
+        // 向后找第一个凑够 MinLength 的句末；找不到就退到最后一个句末或词边界
+        int cut = -1, lastSentence = -1, lastSpace = -1;
+        int i = pos;
+        for (; i < n && i - pos < MaxLength; ++i) {
+            if (text.at(i).isSpace()) lastSpace = i;
+            if (!isSentenceEnd(text, i)) continue;
+            int end = i + 1;
+            while (end < n && isClosing(text.at(end))) ++end;
+            if (end - pos >= MinLength) {
+                cut = end;
+                break;
+            }
+            lastSentence = end;
+        }
+        if (cut < 0) {
+            if (i >= n) cut = n;
+            else if (lastSentence > pos) cut = lastSentence;
+            else if (lastSpace > pos) cut = lastSpace;
+            else cut = i;
+        }
+
+        int end = cut;
+        while (end > pos && text.at(end - 1).isSpace()) --end;
+
+        Passage p;
+        p.article = article;
+        measure(text, pos, end - pos, p);
+        const int id = m_passages.size();
+        if (m_firstPassage[article] < 0) m_firstPassage[article] = id;
+        m_passages.append(p);
+        m_buckets[p.bucket].append(id);
+        pos = cut;
+    }
+    return article;
+}
+
+void PassageIndex::measure(const QString& text, int offset, int length, Passage& p) {
+    p.offset = offset;
+    p.length = length;
+    p.letters = p.upper = p.digits = p.punctuation = p.spaces = p.other = 0;
+
+    const QChar* s = text.constData() + offset;
+    for (int i = 0; i < length; ++i) {
+        const ushort u = s[i].unicode();
+        if (u >= 'a' && u <= 'z') p.letters++;
+        else if (u >= 'A' && u <= 'Z') { p.letters++; p.upper++; }
+        else if (u >= '0' && u <= '9') p.digits++;
+        else if (u == ' ') p.spaces++;
+        else if (u < 0x80) p.punctuation++;
+        else p.other++;
+    }
+
+    // 难度分：词越长、大写/数字/标点/非 ASCII 越多越难，段落越长越难。
+    // 普通英文段落约为 1.5，落在中间档
+    const double len = qMax(1, length);
+    const double avgWord = double(p.letters) / (p.spaces + 1);
+    p.difficulty = qMax(0.0, 0.4 * (avgWord - 4.0))
+        + 6.0 * p.upper / len + 8.0 * p.digits / len + 5.0 * p.punctuation / len + 10.0 * p.other / len
+        + len / MaxLength;
+    p.bucket = qBound(0, int((p.difficulty - 0.5) / 0.5), BucketCount - 1);
+}
+
+QString PassageIndex::text(int id) const {
+    const Passage& p = m_passages[id];
+    return m_articles[p.article].mid(p.offset, p.length);
+}
+
+int PassageIndex::nextPassage(int id) const {
+    const int next = id + 1;
+    return next < m_passages.size() && m_passages[next].article == m_passages[id].article ? next : -1;
+}
+
+int PassageIndex::randomPassage(GameRandom& rng, int bucket) const {
+    if (m_passages.isEmpty()) return -1;
+    if (bucket < 0) return rng.bounded(m_passages.size());
+
+    // 由近到远找非空档：bucket, bucket+1, bucket-1, ...
+    bucket = qBound(0, bucket, BucketCount - 1);
+    for (int d = 0; d < BucketCount; ++d) {
+        for (int b : { bucket + d, bucket - d }) {
+            if (b < 0 || b >= BucketCount || m_buckets[b].isEmpty()) continue;
+            return m_buckets[b][rng.bounded(m_buckets[b].size())];
+        }
+    }
+    return -1;
+}
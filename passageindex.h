@@ -0,0 +1,67 @@
+﻿#ifndef PASSAGEINDEX_H
+#define PASSAGEINDEX_H
+
+#include "gamecore_global.h"
+#include "gamerandom.h"
+#include <QStringList>
+#include <QVector>
+
+// 文章切段索引
+// 文章载入时一次性按句子切成 MinLength-MaxLength 字符的段落，同时算好每段的
+// 字符构成和难度分，按难度分入 BucketCount 个档位。之后取"同一篇的下一段"
+// 或"某个难度档的随机一段"都是 O(1)，长文章可以一段接一段打完。
+class GAMECORE_EXPORT PassageIndex {
+public:
+    static const int MinLength = 120;  // 凑够这么长且遇到句末才切
+    static const int MaxLength = 300;  // 超长的句子在词边界处硬切
+    static const int BucketCount = 5;  // 难度档：0 最简单
+
+    struct Passage {
+        int article;
+        int offset;       // 在文章中的位置
+        int length;
+        int letters;      // A-Z a-z
+        int upper;
+        int digits;
+        int punctuation;  // ASCII 标点和符号
+        int spaces;
+        int other;        // 非 ASCII（中文、全角标点等）
+        double difficulty;
+        int bucket;
+    };
+
+    void clear();
+
+    // 切段并加入索引，返回文章编号
+    int addArticle(const QString& text);
+    // 换掉一篇文章的内容（文件改过）：文章编号不变，全部段落重新切分编号，
+    // 之前拿到的段落编号失效。文章数不变，索引不会随反复修改而增长
+    void replaceArticle(int article, const QString& text);
+    // 该编号的文章内容是否仍是 text（文件改过时调用方 replaceArticle）
+    bool articleMatches(int article, const QString& text) const { return m_articles.value(article) == text; }
+
+    int articleCount() const { return m_articles.size(); }
+    int passageCount() const { return m_passages.size(); }
+    const Passage& passage(int id) const { return m_passages[id]; }
+    const QString& article(int id) const { return m_articles[id]; }
+    QString text(int id) const;
+
+    int firstPassage(int article) const { return m_firstPassage.value(article, -1); }
+    // 同一篇的下一段，已是最后一段返回 -1
+    int nextPassage(int id) const;
+    // 指定难度档里随机一段；该档为空时取最近的非空档，bucket < 0 时不限难度。索引为空返回 -1
+    int randomPassage(GameRandom& rng, int bucket = -1) const;
+
+    // 字符构成 -> 难度分和档位
+    static void measure(const QString& text, int offset, int length, Passage& passage);
+
+private:
+    static bool isSentenceEnd(const QString& text, int i);
+
+    QStringList m_articles;
+    QVector<Passage> m_passages;      // 同一篇文章的段落连续存放
+    QVector<int> m_firstPassage;      // 文章 -> 第一段，没有段落为 -1
+    QVector<int> m_buckets[BucketCount];
+};
+
+#endif // PASSAGEINDEX_H
@@ -0,0 +1,87 @@
+﻿#include "typistgame.h"
+
+const int TYPIST_ROUND_SEC = 60;
+
+TypistGame::TypistGame(QObject* parent) : GameBase(parent), m_remainingSec(TYPIST_ROUND_SEC) {
+    m_secondTimer = new QTimer(this);
+    m_secondTimer->setInterval(1000);
+    connect(m_secondTimer, &QTimer::timeout, this, &TypistGame::onSecond);
+    initGame();
+}
+
+void TypistGame::initGame() {
+    m_state = GameState::Ready;
+    m_score = 0;
+    m_remainingSec = TYPIST_ROUND_SEC;
+    m_secondTimer->stop();
+    nextLetter();
+    emit scoreChanged(0);
+}
+
+void TypistGame::startGame() {
+    if (m_state == GameState::Ready || m_state == GameState::GameOver) {
+        initGame();
+        m_state = GameState::Playing;
+        beginSession();
+        m_secondTimer->start();
+    }
+}
+
+void TypistGame::pauseGame() {
+    if (m_state == GameState::Playing) {
+        m_state = GameState::Paused;
+        pauseSession();
+        m_secondTimer->stop();
+    }
+    else if (m_state == GameState::Paused) {
+        m_state = GameState::Playing;
+        resumeSession();
+        m_secondTimer->start();
+    }
+}
+
+void TypistGame::stopGame() {
+    m_state = GameState::GameOver;
+    m_secondTimer->stop();
+}
+
+void TypistGame::draw(QPainter& painter) {
+    painter.fillRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, QColor(40, 60, 90));
+
+    QFont font = painter.font();
+    font.setPixelSize(24);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    painter.drawText(QRect(20, 20, 300, 40), Qt::AlignLeft | Qt::AlignVCenter,
+        QStringLiteral("得分：%1").arg(m_score));
+    painter.drawText(QRect(SCREEN_WIDTH - 320, 20, 300, 40), Qt::AlignRight | Qt::AlignVCenter,
+        QStringLiteral("剩余：%1 秒").arg(m_remainingSec));
+
+    font.setPixelSize(160);
+    font.setBold(true);
+    painter.setFont(font);
+    painter.drawText(QRect(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT), Qt::AlignCenter, QString(m_target));
+}
+
+void TypistGame::handleKeyPress(QKeyEvent* event) {
+    if (m_state != GameState::Playing) return;
+    const QString text = event->text().toUpper();
+    if (text.isEmpty() || !text.at(0).isLetter()) return;
+
+    reportKeystroke(m_target, text.at(0));
+    if (text.at(0) == m_target) {
+        m_score++;
+        emit scoreChanged(m_score);
+        nextLetter();
+    }
+}
+
+void TypistGame::onSecond() {
+    if (--m_remainingSec > 0) return;
+    stopGame();
+    emit gameFinished(m_score, true);
+}
+
+void TypistGame::nextLetter() {
+    m_target = QChar('A' + int(m_rng.bounded(26)));
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+﻿#ifndef TYPISTGAME_H
+#define TYPISTGAME_H
+
+#include "gamebase.h"
+#include <QTimer>
+
+// 示例插件游戏：屏幕中间出一个字母，一分钟内按对的越多分越高。
+// 只用 GameBase 的公开接口和核心库的服务，演示第三方游戏怎样以插件形式接入
+class TypistGame : public GameBase {
+    Q_OBJECT
+
+public:
+    explicit TypistGame(QObject* parent = nullptr);
+
+    void initGame() override;
+    void startGame() override;
+    void pauseGame() override;
+    void stopGame() override;
+    void draw(QPainter& painter) override;
+    void handleKeyPress(QKeyEvent* event) override;
+    QString gameId() const override { return QStringLiteral("typist"); }
+
+private slots:
+    void onSecond();
+
+private:
+    void nextLetter();
+
+    QTimer* m_secondTimer;
+    int m_remainingSec;
+    QChar m_target;
+};
+
+#endif // TYPISTGAME_H
\ No newline at end of file
@@ -0,0 +1,18 @@
+﻿#ifndef TYPISTPLUGIN_H
+#define TYPISTPLUGIN_H
+
+#include "gameplugin.h"
+#include "typistgame.h"
+
+// 插件入口：typist.json 里的 id/name/order 在启动时被读出来生成菜单项，
+// 玩家选中“打字练习”时才加载本库并调用 createGame
+class TypistPlugin : public QObject, public GamePluginInterface {
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID GamePluginInterface_iid FILE "typist.json")
+    Q_INTERFACES(GamePluginInterface)
+
+public:
+    GameBase* createGame(QObject* parent) override { return new TypistGame(parent); }
+};
+
+#endif // TYPISTPLUGIN_H
\ No newline at end of file
@@ -1,65 +1,87 @@
-﻿#ifndef POLICEGAME_H
-#define POLICEGAME_H
-
-#include "gamebase.h"
-#include "policegamesettings.h"
-#include <QPixmap>
-#include <QTimer>
-#include <QVector>
-#include <QPointF>
-
-class PoliceGame : public GameBase {
-    Q_OBJECT
-public:
-    explicit PoliceGame(QObject* parent = nullptr);
-    ~PoliceGame();
-
-    void initGame() override;
-    void startGame() override;
-    void pauseGame() override;
-    void stopGame() override;
-    void draw(QPainter& painter) override;
-    void handleKeyPress(QKeyEvent* event) override;
-
-    void updateSettings(const PoliceSettingsData& settings);
-
-    // 获取当前角色 (0:警察, 1:小偷)，供结算界面使用
-    int getRole() const { return m_settings.role; }
-
-private slots:
-    void onGameTick();
-
-private:
-    void initMapPath();
-    void loadResources();
-    void loadArticle(const QString& filename = "");
-
-    void getCarState(double distance, int direction, const QVector<QPixmap>& sprites,
-        QPointF& outPos, QPixmap& outSprite);
-
-    QPixmap m_bgPixmap;
-    QPixmap m_uiInputBg;
-    QPixmap m_uiProgressBar;
-
-    QVector<QPixmap> m_policeSprites;
-    QVector<QPixmap> m_thiefSprites;
-
-    QString m_targetText;
-    int m_currentIndex;
-    bool m_isTypingError;
-
-    double m_totalMapLength;
-    double m_playerDistance;
-    double m_enemyDistance;
-    double m_playerSpeed;
-    double m_playerBaseSpeed;
-    double m_enemySpeed;
-
-    int m_direction;
-
-    QVector<QPointF> m_pathPoints;
-    QTimer* m_physicsTimer;
-    PoliceSettingsData m_settings;
-};
-
+﻿#ifndef POLICEGAME_H
+#define POLICEGAME_H
+
+#include "gamecore_global.h"
+#include "gamebase.h"
+#include "policegamesettings.h"
+#include "typingribbon.h"
+#include <QPixmap>
+#include <QTimer>
+#include <QVector>
+#include <QPointF>
+
+class GAMECORE_EXPORT PoliceGame : public GameBase {
+    Q_OBJECT
+public:
+    explicit PoliceGame(QObject* parent = nullptr);
+    ~PoliceGame();
+
+    void initGame() override;
+    void startGame() override;
+    void pauseGame() override;
+    void stopGame() override;
+    void draw(QPainter& painter) override;
+    void handleKeyPress(QKeyEvent* event) override;
+    QString gameId() const override { return QStringLiteral("police"); }
+    const GameCapabilities& capabilities() const override;
+    SettingsResult execSettings(QWidget* parent) override;
+    void applySettings() override { updateSettings(m_pendingSettings); }
+    int resultRole() const override { return getRole(); }
+
+    void updateSettings(const PoliceSettingsData& settings);
+
+    // 获取当前角色 (0:警察, 1:小偷)，供结算界面使用
+    int getRole() const { return m_settings.role; }
+
+protected:
+    void saveState(QDataStream& out) const override;
+    bool restoreState(QDataStream& in) override;
+
+private slots:
+    void onGameTick();
+
+private:
+    friend class BenchAccess; // 基准测试直接构造内部状态
+
+    void initMapPath();
+    void loadResources();
+    void loadArticle(const QString& filename = "");
+    void nextPassage();       // 警察打完一段：接着同一篇的下一段
+    int preferredBucket() const; // 随机选段时的难度档，跟随难度倍率
+    void showPassageInRibbon();  // 段落变化后更新打字条的文本和起点
+
+    void getCarState(double distance, int direction, const QVector<QPixmap>& sprites,
+        QPointF& outPos, QPixmap& outSprite);
+
+    QPixmap m_bgPixmap;
+    QPixmap m_uiInputBg;
+    QPixmap m_uiProgressBar;
+
+    QVector<QPixmap> m_policeSprites;
+    QVector<QPixmap> m_thiefSprites;
+
+    QString m_targetText;     // 当前段落
+    int m_passageId;          // DataManager::passages() 中的编号，-1 表示没有可用段落
+    int m_currentIndex;
+    bool m_isTypingError;
+
+    TypingRibbon m_ribbon;
+    int m_ribbonBase;         // 当前段落在打字条文本中的起点
+
+    double m_totalMapLength;
+    double m_playerDistance;
+    double m_enemyDistance;
+    double m_playerSpeed;
+    double m_playerBaseSpeed;
+    double m_enemySpeed;
+
+    int m_direction;
+
+    QVector<QPointF> m_pathPoints;
+    QTimer* m_physicsTimer;
+    PoliceSettingsData m_settings;
+    PoliceGameSettings* m_settingsDialog = nullptr; // 选中游戏和游戏内设置共用，保留上次的选择
+    PoliceSettingsData m_pendingSettings;
+};
+
 #endif // POLICEGAME_H
\ No newline at end of file
@@ -0,0 +1,138 @@
+﻿#include "recordlog.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+#include <QDebug>
+
+const int HEADER_SIZE = 8;
+const int RECORD_HEADER_SIZE = 6;
+// 单条记录的上限，长度字段超出说明读到了损坏的数据
+const quint32 MAX_RECORD_SIZE = 1 << 20;
+
+RecordLog::RecordLog(quint32 magic, quint16 version)
+    : m_magic(magic), m_version(version), m_recordCount(0), m_readOnly(false) {
+}
+
+int RecordLog::maxRecordSize() {
+    return MAX_RECORD_SIZE;
+}
+
+bool RecordLog::exists() const {
+    return QFileInfo::exists(m_path);
+}
+
+QByteArray RecordLog::header() const {
+    QByteArray h(HEADER_SIZE, '\0');
+    qToLittleEndian<quint32>(m_magic, h.data());
+    qToLittleEndian<quint16>(m_version, h.data() + 4);
+    return h;
+}
+
+QByteArray RecordLog::encode(const QByteArray& payload) {
+    QByteArray record(RECORD_HEADER_SIZE, '\0');
+    qToLittleEndian<quint32>(payload.size(), record.data());
+    qToLittleEndian<quint16>(qChecksum(payload.constData(), payload.size()), record.data() + 4);
+    record.append(payload);
+    return record;
+}
+
+RecordLog::LoadResult RecordLog::load(const std::function<void(const QByteArray&)>& visit) {
+    m_recordCount = 0;
+    m_readOnly = false;
+    QFile file(m_path);
+    if (!file.exists()) return Loaded;
+    if (!file.open(QIODevice::ReadWrite)) {
+        qWarning() << "RecordLog: cannot open" << m_path << file.errorString();
+        m_readOnly = true;
+        return OpenFailed;
+    }
+
+    // 日志由使用方定期压缩，大小有界，一次读入即可
+    const QByteArray data = file.readAll();
+    // 空文件：创建后还没来得及写文件头，append 会补上
+    if (data.isEmpty()) return Loaded;
+    if (data.size() < HEADER_SIZE || data.left(HEADER_SIZE) != header()) {
+        qWarning() << "RecordLog: unknown header in" << m_path;
+        return BadHeader;
+    }
+
+    const char* p = data.constData();
+    int offset = HEADER_SIZE;
+    while (data.size() - offset >= RECORD_HEADER_SIZE) {
+        quint32 size = qFromLittleEndian<quint32>(p + offset);
+        quint16 crc = qFromLittleEndian<quint16>(p + offset + 4);
+        if (size > MAX_RECORD_SIZE || (qint64)size > data.size() - offset - RECORD_HEADER_SIZE) break;
+        const char* payload = p + offset + RECORD_HEADER_SIZE;
+        if (qChecksum(payload, size) != crc) break;
+
+        visit(QByteArray::fromRawData(payload, size));
+        m_recordCount++;
+        offset += RECORD_HEADER_SIZE + size;
+    }
+
+    // 末尾的残缺记录截掉，之后的追加才能接在有效数据后面
+    if (offset < data.size()) {
+        qWarning() << "RecordLog: dropping" << (data.size() - offset) << "trailing bytes in" << m_path;
+        file.resize(offset);
+    }
+    return Loaded;
+}
+
+bool RecordLog::discard() {
+    if (m_readOnly) return false;
+    m_recordCount = 0;
+    const QString backup = m_path + ".bak";
+    QFile::remove(backup);
+    if (!QFile::rename(m_path, backup)) {
+        qWarning() << "RecordLog: cannot move" << m_path << "aside";
+        return false;
+    }
+    qWarning() << "RecordLog: unrecognized file moved to" << backup;
+    return true;
+}
+
+bool RecordLog::append(const QByteArray& payload) {
+    if (m_readOnly) return false;
+    if ((quint32)payload.size() > MAX_RECORD_SIZE) {
+        qWarning() << "RecordLog: record too large for" << m_path << payload.size();
+        return false;
+    }
+    QFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "RecordLog: cannot append to" << m_path;
+        return false;
+    }
+    QByteArray chunk;
+    if (file.size() == 0) chunk = header();
+    chunk.append(encode(payload));
+    if (file.write(chunk) != chunk.size()) return false;
+    if (!file.flush()) return false;
+    m_recordCount++;
+    return true;
+}
+
+bool RecordLog::rewrite(const QVector<QByteArray>& payloads) {
+    if (m_readOnly) return false;
+    for (const QByteArray& payload : payloads) {
+        if ((quint32)payload.size() > MAX_RECORD_SIZE) {
+            qWarning() << "RecordLog: record too large for" << m_path << payload.size();
+            return false;
+        }
+    }
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "RecordLog: cannot rewrite" << m_path;
+        return false;
+    }
+    file.write(header());
+    for (const QByteArray& payload : payloads) {
+        file.write(encode(payload));
+    }
+    if (!file.commit()) {
+        qWarning() << "RecordLog: commit failed for" << m_path;
+        return false;
+    }
+    m_recordCount = payloads.size();
+    return true;
+}
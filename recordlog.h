@@ -0,0 +1,56 @@
+﻿#ifndef RECORDLOG_H
+#define RECORDLOG_H
+
+#include "gamecore_global.h"
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+// 只追加的二进制记录文件
+// 文件头：magic(4) + version(2) + 保留(2)
+// 每条记录：长度(4) + CRC16(2) + 负载，整条记录一次 write 写出。
+// 进程在写入中途崩溃时，文件末尾最多留下半条记录，load 时校验不过就截掉，
+// 之前的记录不受影响。
+// 压缩（rewrite）通过 QSaveFile 写临时文件后原子替换，中途失败旧文件保持原样。
+class GAMECORE_EXPORT RecordLog {
+public:
+    enum LoadResult {
+        Loaded,     // 读入成功（文件不存在或为空视为空日志）
+        OpenFailed, // 文件打不开：内容未知，之后的 append/rewrite 一律不写，避免覆盖它
+        BadHeader   // 文件头不匹配（不是本格式或版本不同），可以用 discard 挪走
+    };
+
+    RecordLog(quint32 magic, quint16 version);
+
+    void setFileName(const QString& path) { m_path = path; m_readOnly = false; }
+    QString fileName() const { return m_path; }
+    bool exists() const;
+
+    // 逐条回调有效记录
+    LoadResult load(const std::function<void(const QByteArray&)>& visit);
+    // 把无法识别的文件改名为 <文件名>.bak（覆盖旧的 .bak），之后从空日志开始
+    bool discard();
+
+    // 超过 maxRecordSize 的记录读回时会被当成损坏，append/rewrite 直接拒绝
+    bool append(const QByteArray& payload);
+    // 用给定记录整体替换文件内容
+    bool rewrite(const QVector<QByteArray>& payloads);
+
+    static int maxRecordSize();
+
+    // 文件中的记录条数（load/append/rewrite 后更新），用来判断何时压缩
+    int recordCount() const { return m_recordCount; }
+
+private:
+    QByteArray header() const;
+    static QByteArray encode(const QByteArray& payload);
+
+    quint32 m_magic;
+    quint16 m_version;
+    QString m_path;
+    int m_recordCount;
+    bool m_readOnly; // 上次 load 打不开文件：只在内存里运行，不动磁盘上的文件
+};
+
+#endif // RECORDLOG_H
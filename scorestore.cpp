@@ -0,0 +1,172 @@
+﻿#include "scorestore.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QSet>
+#include <QTextStream>
+#include <algorithm>
+
+const quint32 SCORE_MAGIC = 0x43535054; // "TPSC"
+const quint16 SCORE_VERSION = 1;
+
+namespace {
+
+QByteArray encodeEntry(const QString& game, int mode, const ScoreEntry& entry) {
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_0);
+    out << game << qint32(mode) << entry.name << qint32(entry.score) << qint64(entry.timestamp);
+    return payload;
+}
+
+bool decodeEntry(const QByteArray& payload, QString& game, int& mode, ScoreEntry& entry) {
+    QDataStream in(payload);
+    in.setVersion(QDataStream::Qt_5_0);
+    qint32 m, score;
+    qint64 timestamp;
+    in >> game >> m >> entry.name >> score >> timestamp;
+    if (in.status() != QDataStream::Ok) return false;
+    mode = m;
+    entry.score = score;
+    entry.timestamp = timestamp;
+    return true;
+}
+
+bool scoreGreater(const ScoreEntry& a, const ScoreEntry& b) {
+    return a.score > b.score;
+}
+
+} // namespace
+
+ScoreStore& ScoreStore::instance() {
+    static ScoreStore instance;
+    return instance;
+}
+
+ScoreStore::ScoreStore() : m_log(SCORE_MAGIC, SCORE_VERSION) {
+    QString dir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath() : QString(".");
+    m_log.setFileName(dir + "/scores.dat");
+    load();
+}
+
+void ScoreStore::setFileName(const QString& path) {
+    m_log.setFileName(path);
+    load();
+}
+
+QString ScoreStore::boardKey(const QString& game, int mode) {
+    return game + QLatin1Char('#') + QString::number(mode);
+}
+
+void ScoreStore::load() {
+    m_boards.clear();
+
+    bool isNew = !m_log.exists();
+    RecordLog::LoadResult result = m_log.load([this](const QByteArray& payload) {
+        QString game;
+        int mode;
+        ScoreEntry entry;
+        if (decodeEntry(payload, game, mode, entry)) insert(game, mode, entry);
+    });
+
+    if (result == RecordLog::OpenFailed) {
+        // 打不开（被占用、没有权限）：文件原样保留，本次只在内存里记录
+        return;
+    }
+    if (result == RecordLog::BadHeader) {
+        // 无法识别的文件：挪到 .bak 留给人工处理，重新开始
+        m_boards.clear();
+        m_log.discard();
+        return;
+    }
+    if (isNew) {
+        importLegacy();
+        return;
+    }
+    compactIfNeeded();
+}
+
+void ScoreStore::importLegacy() {
+    // 旧版格式：每行 "名字,分数,yyyy-MM-dd"，写在当前工作目录
+    QFile file("hiscore.txt");
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return;
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    while (!in.atEnd()) {
+        QStringList parts = in.readLine().split(",");
+        if (parts.size() < 3) continue;
+        QDateTime date(QDate::fromString(parts[2], "yyyy-MM-dd"), QTime(0, 0), Qt::UTC);
+        insert("space", 0, ScoreEntry(parts[0], parts[1].toInt(), date.toMSecsSinceEpoch()));
+    }
+    // 导入结果只保留榜单上用得到的部分
+    compact();
+}
+
+void ScoreStore::insert(const QString& game, int mode, const ScoreEntry& entry) {
+    Board& board = m_boards[boardKey(game, mode)];
+    board.game = game;
+    board.mode = mode;
+
+    // 同分时新记录排在后面
+    auto pos = std::upper_bound(board.top.begin(), board.top.end(), entry, scoreGreater);
+    int index = pos - board.top.begin();
+    if (index < TopCount) {
+        board.top.insert(index, entry);
+        if (board.top.size() > TopCount) board.top.removeLast();
+    }
+
+    auto best = board.best.find(entry.name);
+    if (best == board.best.end()) board.best.insert(entry.name, entry);
+    else if (entry.score > best->score) *best = entry;
+}
+
+void ScoreStore::addScore(const QString& game, int mode, const QString& name, int score) {
+    ScoreEntry entry(name, score, QDateTime::currentMSecsSinceEpoch());
+    insert(game, mode, entry);
+    m_log.append(encodeEntry(game, mode, entry));
+    compactIfNeeded();
+}
+
+QVector<ScoreEntry> ScoreStore::topScores(const QString& game, int mode, int count) const {
+    auto it = m_boards.constFind(boardKey(game, mode));
+    if (it == m_boards.constEnd()) return QVector<ScoreEntry>();
+    return it->top.mid(0, count);
+}
+
+int ScoreStore::personalBest(const QString& game, int mode, const QString& name) const {
+    auto it = m_boards.constFind(boardKey(game, mode));
+    if (it == m_boards.constEnd()) return -1;
+    auto best = it->best.constFind(name);
+    return best == it->best.constEnd() ? -1 : best->score;
+}
+
+void ScoreStore::compactIfNeeded() {
+    int retained = 0;
+    for (const Board& board : m_boards) retained += board.top.size() + board.best.size();
+    // 留出余量，避免每次提交都触发重写
+    if (m_log.recordCount() > retained * 2 + 64) compact();
+}
+
+void ScoreStore::compact() {
+    QVector<QByteArray> payloads;
+    for (const Board& board : m_boards) {
+        // 榜单和个人最佳可能是同一条记录，只写一次
+        QVector<ScoreEntry> entries = board.top;
+        QSet<QString> seen;
+        for (const ScoreEntry& e : board.top) {
+            seen.insert(e.name + QLatin1Char('\n') + QString::number(e.score) + QLatin1Char('\n') + QString::number(e.timestamp));
+        }
+        for (const ScoreEntry& e : board.best) {
+            QString id = e.name + QLatin1Char('\n') + QString::number(e.score) + QLatin1Char('\n') + QString::number(e.timestamp);
+            if (!seen.contains(id)) entries.append(e);
+        }
+        // 按提交时间写回，重新加载时同分的先后顺序不变
+        std::stable_sort(entries.begin(), entries.end(), [](const ScoreEntry& a, const ScoreEntry& b) {
+            return a.timestamp < b.timestamp;
+        });
+        for (const ScoreEntry& e : entries) payloads.append(encodeEntry(board.game, board.mode, e));
+    }
+    m_log.rewrite(payloads);
+}
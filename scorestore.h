@@ -0,0 +1,66 @@
+﻿#ifndef SCORESTORE_H
+#define SCORESTORE_H
+
+#include "gamecore_global.h"
+#include "recordlog.h"
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+struct ScoreEntry {
+    QString name;
+    int score;
+    qint64 timestamp; // 毫秒，UTC
+
+    ScoreEntry() : score(0), timestamp(0) {}
+    ScoreEntry(const QString& n, int s, qint64 t) : name(n), score(s), timestamp(t) {}
+};
+
+// 高分榜存储
+// 每个 (游戏, 模式) 一张榜，内存中只保留前 TopCount 名（按分数降序的有序数组，
+// 二分插入）和每位玩家的个人最佳（哈希表）。
+// 磁盘上是只追加的 scores.dat，每次提交一条记录；条数明显多于内存中保留的
+// 内容时整体重写（压缩），文件大小因此有上限。
+// 首次运行时导入旧版的 hiscore.txt（太空游戏）。
+class GAMECORE_EXPORT ScoreStore {
+public:
+    static ScoreStore& instance();
+
+    static const int TopCount = 100;
+
+    void addScore(const QString& game, int mode, const QString& name, int score);
+
+    // 前 count 名，分数相同时先提交的在前
+    QVector<ScoreEntry> topScores(const QString& game, int mode, int count) const;
+    // 没有记录时返回 -1
+    int personalBest(const QString& game, int mode, const QString& name) const;
+
+    // 测试/基准用：改用指定文件并重新加载
+    void setFileName(const QString& path);
+
+private:
+    ScoreStore();
+    ScoreStore(const ScoreStore&) = delete;
+    ScoreStore& operator=(const ScoreStore&) = delete;
+
+    struct Board {
+        QString game;
+        int mode;
+        QVector<ScoreEntry> top;           // 降序，最多 TopCount 条
+        QHash<QString, ScoreEntry> best;   // 玩家 -> 个人最佳
+
+        Board() : mode(0) {}
+    };
+
+    static QString boardKey(const QString& game, int mode);
+    void load();
+    void importLegacy();
+    void insert(const QString& game, int mode, const ScoreEntry& entry);
+    void compactIfNeeded();
+    void compact();
+
+    RecordLog m_log;
+    QHash<QString, Board> m_boards;
+};
+
+#endif // SCORESTORE_H
@@ -0,0 +1,107 @@
+﻿#include "snapshotstore.h"
+#include "gamebase.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMutexLocker>
+#include <QRunnable>
+
+const quint32 SUSPEND_MAGIC = 0x53535054; // "TPSS"
+const quint16 SUSPEND_VERSION = 1;
+
+class SnapshotStore::FlushTask : public QRunnable {
+public:
+    explicit FlushTask(SnapshotStore* store) : m_store(store) {}
+    void run() override { m_store->runFlush(); }
+
+private:
+    SnapshotStore* m_store;
+};
+
+SnapshotStore& SnapshotStore::instance() {
+    static SnapshotStore instance;
+    return instance;
+}
+
+SnapshotStore::SnapshotStore() : m_log(SUSPEND_MAGIC, SUSPEND_VERSION), m_hasPending(false), m_writing(false) {
+    m_pool.setMaxThreadCount(1);
+
+    QString dir = QCoreApplication::instance() ? QCoreApplication::applicationDirPath() : QString(".");
+    m_log.setFileName(dir + "/suspend.dat");
+    load();
+}
+
+SnapshotStore::~SnapshotStore() {
+    m_pool.waitForDone();
+}
+
+void SnapshotStore::setFileName(const QString& path) {
+    m_pool.waitForDone();
+    m_log.setFileName(path);
+    load();
+}
+
+void SnapshotStore::load() {
+    m_snapshots.clear();
+    RecordLog::LoadResult result = m_log.load([this](const QByteArray& payload) {
+        // 快照版本不符的（程序升级前留下的）读不出 gameId，直接丢弃
+        QString game = GameBase::snapshotGameId(payload);
+        // payload 指向 load 内部的缓冲区，要复制一份再留下
+        if (!game.isEmpty()) m_snapshots.insert(game, QByteArray(payload.constData(), payload.size()));
+    });
+    // 打不开时文件原样保留，本次挂起的局只在内存里；无法识别的文件挪到 .bak
+    if (result == RecordLog::BadHeader) {
+        m_snapshots.clear();
+        m_log.discard();
+    }
+}
+
+bool SnapshotStore::save(const QByteArray& snapshot) {
+    QString game = GameBase::snapshotGameId(snapshot);
+    if (game.isEmpty()) return false;
+    if (snapshot.size() > RecordLog::maxRecordSize()) {
+        // 写进去读回时会被当成损坏的记录。旧快照也不留，免得继续的是更早的进度
+        qWarning() << "SnapshotStore: snapshot of" << game << "too large:" << snapshot.size();
+        remove(game);
+        return false;
+    }
+    // 暂停中的一局每次自动保存都一样，不必重写文件
+    auto it = m_snapshots.constFind(game);
+    if (it != m_snapshots.constEnd() && *it == snapshot) return true;
+    m_snapshots.insert(game, snapshot);
+    flush();
+    return true;
+}
+
+void SnapshotStore::remove(const QString& game) {
+    if (m_snapshots.remove(game) > 0) flush();
+}
+
+void SnapshotStore::flush() {
+    QVector<QByteArray> payloads;
+    payloads.reserve(m_snapshots.size());
+    for (const QByteArray& snapshot : m_snapshots) payloads.append(snapshot);
+
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending = payloads;
+    m_hasPending = true;
+    if (m_writing) return; // 正在运行的任务写完当前这份后会接着写
+    m_writing = true;
+    m_pool.start(new FlushTask(this));
+}
+
+void SnapshotStore::runFlush() {
+    for (;;) {
+        QVector<QByteArray> payloads;
+        {
+            QMutexLocker locker(&m_pendingMutex);
+            if (!m_hasPending) {
+                m_writing = false;
+                return;
+            }
+            payloads.swap(m_pending);
+            m_hasPending = false;
+        }
+        // 失败时旧文件保持原样，下一次保存再试
+        m_log.rewrite(payloads);
+    }
+}
\ No newline at end of file
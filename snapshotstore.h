@@ -0,0 +1,59 @@
+﻿#ifndef SNAPSHOTSTORE_H
+#define SNAPSHOTSTORE_H
+
+#include "gamecore_global.h"
+#include "recordlog.h"
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+// 挂起的游戏快照（GameBase::saveSnapshot）
+// 每个游戏最多保留一份，存放在 suspend.dat：每份一条 RecordLog 记录，
+// 保存时用 QSaveFile 整体重写，写到一半断电旧文件保持原样。
+// 返回主菜单、退出程序时挂起当前这一局，游戏进行中定时自动保存，
+// 这样崩溃或断电之后也能从最近一次保存处继续。
+// 快照和上次保存的相同时不写文件；写文件在后台线程进行，不卡界面，
+// 后台还没写完时又有新的保存，只写最新的那一份。
+class GAMECORE_EXPORT SnapshotStore {
+public:
+    static SnapshotStore& instance();
+
+    bool contains(const QString& game) const { return m_snapshots.contains(game); }
+    QByteArray snapshot(const QString& game) const { return m_snapshots.value(game); }
+
+    // 按快照里的 gameId 覆盖该游戏原有的快照；
+    // 超过 RecordLog::maxRecordSize 的快照拒绝保存并删掉旧快照，返回 false
+    bool save(const QByteArray& snapshot);
+    void remove(const QString& game);
+
+    // 测试/基准用：改用指定文件并重新加载
+    void setFileName(const QString& path);
+    // 等待后台写完（退出前调用）
+    void waitForIdle() { m_pool.waitForDone(); }
+
+private:
+    SnapshotStore();
+    ~SnapshotStore();
+    SnapshotStore(const SnapshotStore&) = delete;
+    SnapshotStore& operator=(const SnapshotStore&) = delete;
+
+    class FlushTask;
+
+    void load();
+    void flush();         // 主线程：整理出要写的记录交给后台
+    void runFlush();      // 后台线程：写到没有待写的内容为止
+
+    RecordLog m_log;      // load 之后只在后台线程使用
+    QHash<QString, QByteArray> m_snapshots; // gameId -> 快照，只在主线程使用
+
+    QThreadPool m_pool;
+    QMutex m_pendingMutex;
+    QVector<QByteArray> m_pending; // 最新一份待写的内容
+    bool m_hasPending;
+    bool m_writing;       // 后台任务正在运行
+};
+
+#endif // SNAPSHOTSTORE_H
\ No newline at end of file
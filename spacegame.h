@@ -1,133 +1,140 @@
-﻿#ifndef SPACEGAME_H
-#define SPACEGAME_H
-
-#include "gamebase.h"
-#include "spacegamesettings.h"
-#include "imagebutton.h"
-#include <QPixmap>
-#include <QList>
-#include <QPointF>
-#include <QtMultimedia/QSoundEffect>
-
-// 定义实体类型
-enum EntityType {
-    Type_Enemy,
-    Type_Bullet,
-    Type_Explosion
-};
-
-// 实体结构体
-struct SpaceEntity {
-    EntityType type;
-    QPointF pos;
-    QPointF velocity;
-    double initialX;
-    QString letter;
-    QString targetLetter;
-    int lifeTime;
-    bool active;
-
-    SpaceEntity(EntityType t, QPointF p, QPointF v, QString l = "")
-        : type(t), pos(p), velocity(v), initialX(p.x()), letter(l), targetLetter(""), lifeTime(0), active(true) {
-    }
-};
-
-class SpaceGame : public GameBase {
-    Q_OBJECT
-public:
-    explicit SpaceGame(QObject* parent = nullptr);
-    ~SpaceGame();
-
-    void initGame() override;
-    void startGame() override;
-    void pauseGame() override;
-    void stopGame() override;
-    void draw(QPainter& painter) override;
-    void handleKeyPress(QKeyEvent* event) override;
-
-    void resumeGame();
-
-signals:
-    void requestReturnToMenu();
-
-private slots:
-    void onGameTick();
-
-    void onBtnStartClicked();
-    void onBtnReturnClicked();
-    void onBtnOptionClicked();
-    void onBtnHiscoreClicked();
-    void onBtnExitClicked();
-    void onBtnGamePauseClicked();
-
-private:
-    void spawnEnemy();
-    void spawnBullet(const QPointF& startPos, const QString& targetLetter);
-    void createExplosion(const QPointF& pos);
-
-    // 碰撞检测
-    bool checkCollisions();
-
-    void drawHUD(QPainter& painter);
-
-    // 输入界面
-    void drawNameInput(QPainter& painter);
-
-    void handleGameOver();
-    void saveScore(const QString& name, int score);
-
-    void setupInternalUI();
-    void showMenuUI(bool isPauseMode);
-    void hideMenuUI();
-    void showGameUI();
-    void hideGameUI();
-
-    // 资源
-    QPixmap m_bgPixmap;
-    QPixmap m_menuBgPixmap;
-    QPixmap m_playerPixmap;
-    QPixmap m_enemyPixmap;
-    QPixmap m_meteorPixmap;
-    QPixmap m_bulletPixmap;
-    QPixmap m_explosionPixmap;
-
-    QPixmap m_inputBgPixmap; // 输入框背景
-
-    QPixmap m_hudLabelScore;
-    QPixmap m_hudLabelLife;
-    QPixmap m_hudLabelTime;
-    QPixmap m_hudLifeIcon;
-
-    ImageButton* m_btnStart;
-    ImageButton* m_btnReturn;
-    ImageButton* m_btnOption;
-    ImageButton* m_btnHiscore;
-    ImageButton* m_btnExit;
-    ImageButton* m_btnGamePause;
-
-    SpaceGameSettings* m_settingsDialog;
-    SpaceSettingsData m_settings;
-
-    QSoundEffect* m_shootSound;
-    QSoundEffect* m_explodeSound;
-    QSoundEffect* m_bgMusic;
-
-    QList<SpaceEntity*> m_entities;
-    QPointF m_playerPos;
-
-    int m_spawnTimer;
-    int m_spawnInterval;
-    int m_lives;
-
-    int m_gameTimeFrames;
-    int m_difficultyLevel;
-    double m_playerDir;
-
-    QTimer* m_physicsTimer;
-
-    // 输入状态控制
-    bool m_isInputActive;
-    QString m_inputName;
-};
-
+﻿#ifndef SPACEGAME_H
+#define SPACEGAME_H
+
+#include "gamecore_global.h"
+#include "gamebase.h"
+#include "spacegamesettings.h"
+#include "imagebutton.h"
+#include "entitypool.h"
+#include <QPixmap>
+#include <QPointF>
+
+// 定义实体类型
+enum EntityType {
+    Type_Enemy,
+    Type_Bullet,
+    Type_Explosion
+};
+
+// 实体结构体
+struct SpaceEntity {
+    EntityType type;
+    QPointF pos;
+    QPointF velocity;
+    double initialX;
+    QString letter;
+    QString targetLetter;
+    int lifeTime;
+    bool active;
+
+    SpaceEntity(EntityType t, QPointF p, QPointF v, QString l = "")
+        : type(t), pos(p), velocity(v), initialX(p.x()), letter(l), targetLetter(""), lifeTime(0), active(true) {
+    }
+};
+
+class GAMECORE_EXPORT SpaceGame : public GameBase {
+    Q_OBJECT
+public:
+    explicit SpaceGame(QObject* parent = nullptr);
+    ~SpaceGame();
+
+    void initGame() override;
+    void startGame() override;
+    void pauseGame() override;
+    void stopGame() override;
+    void draw(QPainter& painter) override;
+    void handleKeyPress(QKeyEvent* event) override;
+    QString gameId() const override { return QStringLiteral("space"); }
+    int difficulty() const override { return m_settings.difficulty; }
+    const GameCapabilities& capabilities() const override;
+    bool canSuspend() const override { return GameBase::canSuspend() && !m_isInputActive; } // 输名字时这一局已经结束
+
+    void resumeGame();
+
+protected:
+    void saveState(QDataStream& out) const override;
+    bool restoreState(QDataStream& in) override;
+
+private slots:
+    void onGameTick();
+
+    void onBtnStartClicked();
+    void onBtnReturnClicked();
+    void onBtnOptionClicked();
+    void onBtnHiscoreClicked();
+    void onBtnExitClicked();
+    void onBtnGamePauseClicked();
+
+private:
+    friend class BenchAccess; // 基准测试直接构造内部状态
+
+    void spawnEnemy();
+    void spawnBullet(const QPointF& startPos, const QString& targetLetter);
+    void createExplosion(const QPointF& pos);
+    void destroyEntity(int index); // 标记失效，本帧结束时统一移除
+
+    // 碰撞检测
+    bool checkCollisions();
+
+    void drawHUD(QPainter& painter);
+
+    // 输入界面
+    void drawNameInput(QPainter& painter);
+
+    void handleGameOver();
+
+    void setupInternalUI();
+    void showMenuUI(bool isPauseMode);
+    void hideMenuUI();
+    void showGameUI();
+    void hideGameUI();
+
+    // 资源
+    QPixmap m_bgPixmap;
+    QPixmap m_menuBgPixmap;
+    QPixmap m_playerPixmap;
+    QPixmap m_enemyPixmap;
+    QPixmap m_meteorPixmap;
+    QPixmap m_bulletPixmap;
+    QPixmap m_explosionPixmap;
+
+    QPixmap m_inputBgPixmap; // 输入框背景
+
+    QPixmap m_hudLabelScore;
+    QPixmap m_hudLabelLife;
+    QPixmap m_hudLabelTime;
+    QPixmap m_hudLifeIcon;
+
+    ImageButton* m_btnStart;
+    ImageButton* m_btnReturn;
+    ImageButton* m_btnOption;
+    ImageButton* m_btnHiscore;
+    ImageButton* m_btnExit;
+    ImageButton* m_btnGamePause;
+
+    SpaceGameSettings* m_settingsDialog;
+    SpaceSettingsData m_settings;
+
+    int m_shootSound;   // AudioMixer 音效 id
+    int m_explodeSound;
+
+    EntityPool<SpaceEntity> m_entities;
+    QPointF m_playerPos;
+
+    int m_spawnTimer;
+    char m_lastLetter; // 上一个生成的字母，用于字母组合加权
+    int m_spawnInterval;
+    int m_lives;
+
+    int m_gameTimeFrames;
+    int m_difficultyLevel;
+    double m_playerDir;
+
+    QTimer* m_physicsTimer;
+
+    // 输入状态控制
+    bool m_isInputActive;
+    QString m_inputName;
+};
+
 #endif // SPACEGAME_H
\ No newline at end of file
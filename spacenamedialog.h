@@ -1,28 +1,29 @@
-﻿#ifndef SPACENAMEDIALOG_H
-#define SPACENAMEDIALOG_H
-
-#include <QDialog>
-#include <QLineEdit>
-#include <QLabel>
-#include "imagebutton.h"
-
-class SpaceNameDialog : public QDialog {
-    Q_OBJECT
-
-public:
-    explicit SpaceNameDialog(int score, QWidget *parent = nullptr);
-    QString getName() const;
-
-protected:
-    void paintEvent(QPaintEvent *event) override;
-
-private:
-    void setupUI();
-
-    int m_score;
-    QLineEdit* m_nameEdit;
-    ImageButton* m_btnOk;
-    QPixmap m_bgPixmap;
-};
-
+﻿#ifndef SPACENAMEDIALOG_H
+#define SPACENAMEDIALOG_H
+
+#include "gamecore_global.h"
+#include <QDialog>
+#include <QLineEdit>
+#include <QLabel>
+#include "imagebutton.h"
+
+class GAMECORE_EXPORT SpaceNameDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit SpaceNameDialog(int score, QWidget *parent = nullptr);
+    QString getName() const;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    void setupUI();
+
+    int m_score;
+    QLineEdit* m_nameEdit;
+    ImageButton* m_btnOk;
+    QPixmap m_bgPixmap;
+};
+
 #endif // SPACENAMEDIALOG_H
\ No newline at end of file
@@ -0,0 +1,33 @@
+﻿#include "spritebatch.h"
+
+SpriteBatch::SpriteBatch(const QPixmap& pixmap, int frameCount) {
+    setPixmap(pixmap, frameCount);
+}
+
+void SpriteBatch::setPixmap(const QPixmap& pixmap, int frameCount) {
+    m_pixmap = pixmap;
+    m_sourceRect = QRectF(0, 0, pixmap.width() / qMax(1, frameCount), pixmap.height());
+    // 高 DPI / 预缩放贴图：源矩形按物理像素，绘制尺寸按逻辑像素
+    m_scale = 1.0 / pixmap.devicePixelRatio();
+    m_logicalW = qRound(m_sourceRect.width() * m_scale);
+    m_logicalH = qRound(m_sourceRect.height() * m_scale);
+}
+
+void SpriteBatch::add(int x, int y, int frame) {
+    if (m_pixmap.isNull()) return;
+    // PixmapFragment 以目标中心定位
+    QPointF center(x + m_logicalW / 2.0, y + m_logicalH / 2.0);
+    m_fragments.append(QPainter::PixmapFragment::create(center,
+        m_sourceRect.translated(frame * m_sourceRect.width(), 0), m_scale, m_scale));
+}
+
+void SpriteBatch::addCentered(const QPointF& center, int frame) {
+    // 按原先 drawPixmap(pos.x() - w / 2, ...) 的整数截断规则取左上角，保证逐像素一致
+    add((int)(center.x() - m_logicalW / 2), (int)(center.y() - m_logicalH / 2), frame);
+}
+
+void SpriteBatch::flush(QPainter& painter) {
+    if (m_fragments.isEmpty()) return;
+    painter.drawPixmapFragments(m_fragments.constData(), m_fragments.size(), m_pixmap);
+    m_fragments.clear();
+}
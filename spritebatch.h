@@ -0,0 +1,40 @@
+﻿#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include "gamecore_global.h"
+#include <QPainter>
+#include <QPixmap>
+#include <QVector>
+
+// 精灵批量绘制：同一张贴图的多次 drawPixmap 先收集起来，最后用一次
+// drawPixmapFragments 提交。OpenGL 绘制引擎会合并成一次纹理绘制，
+// raster 引擎下也省去了逐次的状态切换。
+// 贴图也可以是横向等宽排列的图集（frameCount 帧），每个精灵选一帧。
+class GAMECORE_EXPORT SpriteBatch {
+public:
+    explicit SpriteBatch(const QPixmap& pixmap = QPixmap(), int frameCount = 1);
+
+    // 更换贴图，已收集的精灵保留；长期持有的批次每帧调用，片段缓冲区不会重新分配
+    void setPixmap(const QPixmap& pixmap, int frameCount = 1);
+
+    void reserve(int count) { m_fragments.reserve(count); }
+    bool isEmpty() const { return m_fragments.isEmpty(); }
+
+    // 以左上角放置（与 drawPixmap(int x, int y, pixmap) 的像素位置一致）
+    void add(int x, int y, int frame = 0);
+    // 以中心点放置（与原先 pos - size / 2 的写法一致）
+    void addCentered(const QPointF& center, int frame = 0);
+
+    // 提交并清空
+    void flush(QPainter& painter);
+
+private:
+    QPixmap m_pixmap;
+    QRectF m_sourceRect; // 第 0 帧，其余帧向右平移
+    qreal m_scale;
+    int m_logicalW;
+    int m_logicalH;
+    QVector<QPainter::PixmapFragment> m_fragments;
+};
+
+#endif // SPRITEBATCH_H
@@ -0,0 +1,197 @@
+﻿#include "textimport.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QTextCodec>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTIMPORT_SSE2
+#endif
+
+TextImporter& TextImporter::instance() {
+    static TextImporter instance;
+    return instance;
+}
+
+QString TextImporter::load(const QString& path) {
+    QFileInfo info(path);
+    if (!info.isFile()) return QString();
+
+    const QString key = info.absoluteFilePath();
+    const qint64 size = info.size();
+    const QDateTime modified = info.lastModified();
+    auto it = m_cache.constFind(key);
+    if (it != m_cache.constEnd() && it->size == size && it->modified == modified) return it->text;
+
+    QFile file(key);
+    if (!file.open(QIODevice::ReadOnly)) return QString();
+    Entry entry;
+    entry.size = size;
+    entry.modified = modified;
+    entry.text = normalize(decode(file.readAll()));
+    m_cache.insert(key, entry);
+    return entry.text;
+}
+
+TextImporter::Encoding TextImporter::detect(const QByteArray& data, int* bomLength) {
+    const uchar* p = reinterpret_cast<const uchar*>(data.constData());
+    const int n = data.size();
+    int bom = 0;
+    Encoding encoding;
+
+    if (n >= 3 && p[0] == 0xEF && p[1] == 0xBB && p[2] == 0xBF) {
+        bom = 3;
+        encoding = Utf8;
+    }
+    else if (n >= 2 && p[0] == 0xFF && p[1] == 0xFE) {
+        bom = 2;
+        encoding = Utf16LE;
+    }
+    else if (n >= 2 && p[0] == 0xFE && p[1] == 0xFF) {
+        bom = 2;
+        encoding = Utf16BE;
+    }
+    else if (isValidUtf8(data.constData(), n)) {
+        encoding = Utf8; // 纯 ASCII 也归为 UTF-8
+    }
+    else if (looksLikeGbk(data.constData(), n)) {
+        encoding = Gbk;
+    }
+    else {
+        encoding = Local8Bit;
+    }
+
+    if (bomLength) *bomLength = bom;
+    return encoding;
+}
+
+QString TextImporter::decode(const QByteArray& data) {
+    int bom = 0;
+    const Encoding encoding = detect(data, &bom);
+    const char* begin = data.constData() + bom;
+    const int size = data.size() - bom;
+
+    const char* codecName = nullptr;
+    switch (encoding) {
+    case Utf8:
+        return QString::fromUtf8(begin, size);
+    case Local8Bit:
+        return QString::fromLocal8Bit(begin, size);
+    case Utf16LE:
+        codecName = "UTF-16LE";
+        break;
+    case Utf16BE:
+        codecName = "UTF-16BE";
+        break;
+    case Gbk:
+        codecName = "GBK";
+        break;
+    }
+    QTextCodec* codec = QTextCodec::codecForName(codecName);
+    return codec ? codec->toUnicode(begin, size) : QString::fromLocal8Bit(begin, size);
+}
+
+bool TextImporter::isValidUtf8(const char* data, int size) {
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+    const uchar* end = p + size;
+
+    while (p < end) {
+#ifdef TEXTIMPORT_SSE2
+        // 16 字节都是 ASCII（最高位全为 0）就整块跳过
+        while (end - p >= 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            if (_mm_movemask_epi8(chunk) != 0) break;
+            p += 16;
+        }
+        if (p >= end) break;
+#endif
+        const uchar c = *p;
+        if (c < 0x80) {
+            ++p;
+            continue;
+        }
+
+        // 多字节序列：排除超长编码、代理区和超过 U+10FFFF 的码点
+        int length;
+        uchar min = 0x80, max = 0xBF; // 第二个字节的范围
+        if (c >= 0xC2 && c <= 0xDF) length = 2;
+        else if (c >= 0xE0 && c <= 0xEF) {
+            length = 3;
+            if (c == 0xE0) min = 0xA0;
+            else if (c == 0xED) max = 0x9F;
+        }
+        else if (c >= 0xF0 && c <= 0xF4) {
+            length = 4;
+            if (c == 0xF0) min = 0x90;
+            else if (c == 0xF4) max = 0x8F;
+        }
+        else return false;
+
+        if (end - p < length) return false;
+        if (p[1] < min || p[1] > max) return false;
+        for (int i = 2; i < length; ++i) {
+            if ((p[i] & 0xC0) != 0x80) return false;
+        }
+        p += length;
+    }
+    return true;
+}
+
+bool TextImporter::looksLikeGbk(const char* data, int size) {
+    // GBK 双字节：首字节 0x81-0xFE，次字节 0x40-0xFE（不含 0x7F）
+    const uchar* p = reinterpret_cast<const uchar*>(data);
+    const uchar* end = p + size;
+    int pairs = 0;
+    while (p < end) {
+        const uchar c = *p;
+        if (c < 0x80) {
+            ++p;
+            continue;
+        }
+        if (c == 0x80 || c == 0xFF || end - p < 2) return false;
+        const uchar t = p[1];
+        if (t < 0x40 || t == 0x7F || t == 0xFF) return false;
+        pairs++;
+        p += 2;
+    }
+    return pairs > 0;
+}
+
+QString TextImporter::normalize(const QString& text) {
+    QString result(text.size(), Qt::Uninitialized);
+    QChar* out = result.data();
+    const QChar* in = text.constData();
+    const QChar* end = in + text.size();
+
+    int length = 0;
+    bool pendingSpace = false;
+    for (; in < end; ++in) {
+        const ushort u = in->unicode();
+        bool space;
+        if (u < 0x80) {
+            if (u > 0x20 && u != 0x7F) {
+                if (pendingSpace && length > 0) out[length++] = QLatin1Char(' ');
+                pendingSpace = false;
+                out[length++] = *in;
+                continue;
+            }
+            space = u == ' ' || (u >= '\t' && u <= '\r');
+            if (!space) continue; // 其余控制字符直接丢弃
+        }
+        else {
+            if (u == 0xFEFF) continue; // 文件拼接时夹在中间的 BOM
+            space = in->isSpace();
+        }
+
+        if (space) {
+            pendingSpace = true;
+        }
+        else {
+            if (pendingSpace && length > 0) out[length++] = QLatin1Char(' ');
+            pendingSpace = false;
+            out[length++] = *in;
+        }
+    }
+    result.truncate(length);
+    return result;
+}
@@ -0,0 +1,52 @@
+﻿#ifndef TEXTIMPORT_H
+#define TEXTIMPORT_H
+
+#include "gamecore_global.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+
+// 文章导入：识别编码、解码、整理空白，结果按文件缓存
+// 编码按顺序判断：BOM（UTF-8 / UTF-16）-> 整个文件是合法 UTF-8 -> 符合 GBK 双字节规则 -> 本地编码。
+// UTF-8 校验用 SSE2 一次跳过 16 字节纯 ASCII，只对多字节序列逐字节检查。
+// 缓存以路径、大小和修改时间为键，文件没变就不再读取。只在 GUI 线程使用。
+class GAMECORE_EXPORT TextImporter {
+public:
+    static TextImporter& instance();
+
+    enum Encoding {
+        Utf8,
+        Utf16LE,
+        Utf16BE,
+        Gbk,
+        Local8Bit
+    };
+
+    // 读取并整理文件内容；读不了返回空字符串
+    QString load(const QString& path);
+
+    // 以下不经过缓存，供 load 和基准测试使用
+    static Encoding detect(const QByteArray& data, int* bomLength = nullptr);
+    static QString decode(const QByteArray& data);
+    static bool isValidUtf8(const char* data, int size);
+    static bool looksLikeGbk(const char* data, int size);
+    // 换行、制表符、全角空格等所有空白合并成一个空格，去掉首尾空白和控制字符
+    static QString normalize(const QString& text);
+
+    void clearCache() { m_cache.clear(); }
+
+private:
+    TextImporter() {}
+    TextImporter(const TextImporter&) = delete;
+    TextImporter& operator=(const TextImporter&) = delete;
+
+    struct Entry {
+        qint64 size;
+        QDateTime modified;
+        QString text;
+    };
+    QHash<QString, Entry> m_cache;
+};
+
+#endif // TEXTIMPORT_H
@@ -0,0 +1,257 @@
+﻿#include "typinganalytics.h"
+#include <QCoreApplication>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QTimer>
+#include <cstring>
+
+// 滚动窗口与平滑参数
+const qint64 WPM_WINDOW_US = 60 * 1000 * 1000;
+const int ACCURACY_WINDOW = 200;
+const double EWMA_ALPHA = 0.1;
+const double MAX_LATENCY_MS = 2000.0; // 更长的间隔视为停顿，不计入平均
+const int PROCESS_INTERVAL_MS = 10;
+
+TypingMetrics::TypingMetrics()
+    : keystrokes(0), dropped(0), wpm(0.0), accuracy(-1.0), meanLatencyMs(0.0) {
+    std::memset(keyAttempts, 0, sizeof(keyAttempts));
+    std::memset(latencyHistogram, 0, sizeof(latencyHistogram));
+    std::memset(bigramAttempts, 0, sizeof(bigramAttempts));
+    for (int i = 0; i < KeyCount; ++i) {
+        keyErrorRate[i] = 0.0;
+        keyLatencyMs[i] = 0.0;
+    }
+    for (int i = 0; i < BigramCount; ++i) bigramErrorRate[i] = 0.0;
+}
+
+int TypingMetrics::keyOf(QChar c) {
+    ushort u = c.unicode();
+    if (u == 0 || u >= KeyCount) return -1;
+    if (u >= 'a' && u <= 'z') u -= 'a' - 'A';
+    return u;
+}
+
+int TypingMetrics::histogramBin(double latencyMs) {
+    int bin = 0;
+    double upper = 10.0;
+    while (latencyMs >= upper && bin < HistogramBins - 1) {
+        upper *= 2.0;
+        bin++;
+    }
+    return bin;
+}
+
+// 分析线程上的消费者：持有滚动窗口的中间状态
+class AnalyticsWorker : public QObject {
+public:
+    explicit AnalyticsWorker(TypingAnalytics* owner)
+        : m_owner(owner), m_accuracyPos(0), m_accuracyCount(0), m_accuracySum(0), m_latencySamples(0), m_prevLetter(-1) {
+        std::memset(m_accuracyWindow, 0, sizeof(m_accuracyWindow));
+    }
+
+    void start() {
+        QTimer* timer = new QTimer(this);
+        timer->setInterval(PROCESS_INTERVAL_MS);
+        connect(timer, &QTimer::timeout, this, [this]() { drain(); });
+        timer->start();
+    }
+
+    void drain() {
+        KeystrokeEvent e;
+        bool changed = false;
+        while (m_owner->pop(e)) {
+            process(e);
+            changed = true;
+        }
+        // 没有新按键时 WPM 也会随窗口滑动下降
+        if (changed || !m_correctTimes.isEmpty()) finish();
+    }
+
+    void reset() {
+        KeystrokeEvent e;
+        while (m_owner->pop(e)) {}
+        m_metrics = TypingMetrics();
+        m_correctTimes.clear();
+        std::memset(m_accuracyWindow, 0, sizeof(m_accuracyWindow));
+        m_accuracyPos = 0;
+        m_accuracyCount = 0;
+        m_accuracySum = 0;
+        m_latencySamples = 0;
+        m_prevLetter = -1;
+        finish();
+    }
+
+private:
+    static void smooth(double& value, double sample, bool first) {
+        value = first ? sample : value + EWMA_ALPHA * (sample - value);
+    }
+
+    void process(const KeystrokeEvent& e) {
+        TypingMetrics& m = m_metrics;
+        m.keystrokes++;
+        const bool correct = e.expected != 0 && e.expected == e.actual;
+
+        // 命中率：固定长度的滑动窗口，维护窗口内的命中数
+        if (m_accuracyCount == ACCURACY_WINDOW) m_accuracySum -= m_accuracyWindow[m_accuracyPos];
+        else m_accuracyCount++;
+        m_accuracyWindow[m_accuracyPos] = correct;
+        m_accuracySum += correct;
+        m_accuracyPos = (m_accuracyPos + 1) % ACCURACY_WINDOW;
+
+        if (correct) m_correctTimes.enqueue(e.timestampUs);
+        trim(e.timestampUs);
+
+        // 按键间隔（第一次按键没有间隔）
+        const double latencyMs = e.latencyUs / 1000.0;
+        const bool hasLatency = e.latencyUs > 0 && latencyMs < MAX_LATENCY_MS;
+        if (e.latencyUs > 0) m.latencyHistogram[TypingMetrics::histogramBin(latencyMs)]++;
+        if (hasLatency) {
+            smooth(m.meanLatencyMs, latencyMs, m_latencySamples == 0);
+            m_latencySamples++;
+        }
+
+        // 按目标键统计
+        int key = TypingMetrics::keyOf(QChar(e.expected));
+        if (key >= 0) {
+            const bool first = m.keyAttempts[key] == 0;
+            m.keyAttempts[key]++;
+            smooth(m.keyErrorRate[key], correct ? 0.0 : 1.0, first);
+            if (hasLatency) smooth(m.keyLatencyMs[key], latencyMs, m.keyLatencyMs[key] == 0.0);
+        }
+
+        // 字母组合：只在连续输入时统计，停顿之后重新开始
+        const int letter = key >= 'A' && key <= 'Z' ? key - 'A' : -1;
+        if (letter >= 0 && m_prevLetter >= 0 && hasLatency) {
+            const int bigram = TypingMetrics::bigramOf(m_prevLetter, letter);
+            smooth(m.bigramErrorRate[bigram], correct ? 0.0 : 1.0, m.bigramAttempts[bigram] == 0);
+            m.bigramAttempts[bigram]++;
+        }
+        m_prevLetter = letter;
+    }
+
+    void trim(qint64 nowUs) {
+        while (!m_correctTimes.isEmpty() && m_correctTimes.head() < nowUs - WPM_WINDOW_US) {
+            m_correctTimes.dequeue();
+        }
+    }
+
+    void finish() {
+        TypingMetrics& m = m_metrics;
+        const qint64 nowUs = m_owner->m_clock.nsecsElapsed() / 1000;
+        trim(nowUs);
+
+        if (m_correctTimes.isEmpty()) {
+            m.wpm = 0.0;
+        }
+        else {
+            // 刚开始打字时按实际经过的时间计算（至少 1 秒），之后按完整窗口
+            double spanMs = qBound<double>(1000.0, (nowUs - m_correctTimes.head()) / 1000.0, WPM_WINDOW_US / 1000.0);
+            m.wpm = (m_correctTimes.size() / 5.0) / (spanMs / 60000.0);
+        }
+        m.accuracy = m_accuracyCount > 0 ? double(m_accuracySum) / m_accuracyCount : -1.0;
+        m.dropped = m_owner->m_dropped.load();
+        m_owner->publish(m);
+    }
+
+    TypingAnalytics* m_owner;
+    TypingMetrics m_metrics;
+
+    QQueue<qint64> m_correctTimes; // 窗口内正确按键的时间
+    bool m_accuracyWindow[ACCURACY_WINDOW];
+    int m_accuracyPos;
+    int m_accuracyCount;
+    int m_accuracySum;
+    quint64 m_latencySamples;
+    int m_prevLetter; // 上一次的目标字母，0-25；没有时为 -1
+};
+
+TypingAnalytics& TypingAnalytics::instance() {
+    static TypingAnalytics instance;
+    return instance;
+}
+
+TypingAnalytics::TypingAnalytics()
+    : m_head(0), m_tail(0), m_dropped(0), m_lastKeyUs(-1), m_worker(nullptr) {
+    m_clock.start();
+
+    m_thread.setObjectName("TypingAnalytics");
+    m_thread.start(QThread::LowPriority);
+
+    m_worker = new AnalyticsWorker(this);
+    m_worker->moveToThread(&m_thread);
+    AnalyticsWorker* worker = m_worker;
+    QMetaObject::invokeMethod(m_worker, [worker]() { worker->start(); }, Qt::QueuedConnection);
+
+    if (QCoreApplication::instance()) {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, [this]() { shutdown(); });
+    }
+}
+
+TypingAnalytics::~TypingAnalytics() {
+    shutdown();
+}
+
+void TypingAnalytics::shutdown() {
+    if (!m_worker) return;
+
+    AnalyticsWorker* worker = m_worker;
+    m_worker = nullptr;
+    QMetaObject::invokeMethod(worker, [worker]() { delete worker; }, Qt::BlockingQueuedConnection);
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void TypingAnalytics::record(QChar expected, QChar actual) {
+    const qint64 nowUs = m_clock.nsecsElapsed() / 1000;
+    const quint32 head = m_head.load();
+    if (head - m_tail.loadAcquire() >= (quint32)RingCapacity) {
+        m_dropped.fetchAndAddRelaxed(1);
+        return;
+    }
+
+    KeystrokeEvent& e = m_ring[head & (RingCapacity - 1)];
+    e.timestampUs = nowUs;
+    e.latencyUs = m_lastKeyUs < 0 ? 0 : (quint32)qMin<qint64>(nowUs - m_lastKeyUs, 0xFFFFFFFF);
+    e.expected = expected.unicode();
+    e.actual = actual.unicode();
+    m_lastKeyUs = nowUs;
+
+    m_head.storeRelease(head + 1);
+}
+
+bool TypingAnalytics::pop(KeystrokeEvent& event) {
+    const quint32 tail = m_tail.load();
+    if (tail == m_head.loadAcquire()) return false;
+    event = m_ring[tail & (RingCapacity - 1)];
+    m_tail.storeRelease(tail + 1);
+    return true;
+}
+
+void TypingAnalytics::publish(const TypingMetrics& metrics) {
+    QMutexLocker locker(&m_publishMutex);
+    m_published = metrics;
+}
+
+TypingMetrics TypingAnalytics::metrics() const {
+    QMutexLocker locker(&m_publishMutex);
+    return m_published;
+}
+
+void TypingAnalytics::flush() {
+    if (!m_worker) return;
+    AnalyticsWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->drain(); }, Qt::BlockingQueuedConnection);
+}
+
+void TypingAnalytics::reset() {
+    m_lastKeyUs = -1; // 下一次按键没有间隔
+    if (!m_worker) {
+        TypingMetrics empty;
+        empty.dropped = m_dropped.load();
+        publish(empty);
+        return;
+    }
+    AnalyticsWorker* worker = m_worker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->reset(); }, Qt::BlockingQueuedConnection);
+}
@@ -0,0 +1,98 @@
+﻿#ifndef TYPINGANALYTICS_H
+#define TYPINGANALYTICS_H
+
+#include "gamecore_global.h"
+#include <QAtomicInteger>
+#include <QChar>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+
+class AnalyticsWorker;
+
+// 一次按键
+struct KeystrokeEvent {
+    qint64 timestampUs;
+    quint32 latencyUs;  // 距上一次按键
+    ushort expected;    // 应该按的字符，0 表示当时没有目标
+    ushort actual;
+};
+
+// 实时打字指标（滚动窗口 + 指数平滑，按键越多越贴近最近的水平）
+struct TypingMetrics {
+    static const int KeyCount = 128;      // 只统计 ASCII，字母不分大小写
+    static const int HistogramBins = 16;  // 按键间隔：<10ms, 10-20, 20-40, ... 对数分桶
+    static const int LetterCount = 26;
+    static const int BigramCount = LetterCount * LetterCount; // 连续两个目标字母，只统计 A-Z
+
+    quint64 keystrokes;
+    quint64 dropped;            // 缓冲区满被丢弃的按键
+    double wpm;                 // 最近 60 秒正确字符数 / 5 / 分钟
+    double accuracy;            // 最近 200 次按键的命中率，没有数据时为 -1
+    double meanLatencyMs;       // 按键间隔的指数平均（超过 2 秒的停顿不计）
+
+    quint32 keyAttempts[KeyCount];
+    double keyErrorRate[KeyCount];   // 以该键为目标时出错的指数平均
+    double keyLatencyMs[KeyCount];   // 以该键为目标时按键间隔的指数平均
+    quint32 latencyHistogram[HistogramBins];
+    quint32 bigramAttempts[BigramCount];
+    double bigramErrorRate[BigramCount];  // 前一个目标是 a 时按 b 出错的指数平均
+
+    TypingMetrics();
+    static int keyOf(QChar c); // 字符 -> 统计下标，不统计的返回 -1
+    static int histogramBin(double latencyMs);
+    static int bigramOf(int prevLetter, int letter) { return prevLetter * LetterCount + letter; } // 字母下标 0-25
+};
+
+// 打字分析引擎
+// 各游戏在 handleKeyPress 里经 GameBase::reportKeystroke 提交按键：
+// 输入线程只往单生产者/单消费者的无锁环形缓冲区写一条记录，不加锁、不分配内存。
+// 后台线程每 10ms 取出新记录，逐条 O(1) 更新指标，再把结果发布给读取方。
+class GAMECORE_EXPORT TypingAnalytics {
+public:
+    static TypingAnalytics& instance();
+
+    static const int RingCapacity = 4096; // 2 的幂
+
+    // 仅限 GUI 线程调用；缓冲区满时丢弃并计数
+    void record(QChar expected, QChar actual);
+
+    // 最近一次发布的指标（最多滞后一个处理周期）
+    TypingMetrics metrics() const;
+
+    // 立即处理缓冲区中的全部按键并发布（基准测试、需要最新数据时）
+    void flush();
+
+    // 清空全部指标和滚动窗口，缓冲区中还没处理的按键一并丢弃（换玩家时）。仅限 GUI 线程调用
+    void reset();
+
+    void shutdown(); // 停止分析线程（程序退出前调用）
+
+private:
+    friend class AnalyticsWorker;
+
+    TypingAnalytics();
+    ~TypingAnalytics();
+    TypingAnalytics(const TypingAnalytics&) = delete;
+    TypingAnalytics& operator=(const TypingAnalytics&) = delete;
+
+    bool pop(KeystrokeEvent& event);
+    void publish(const TypingMetrics& metrics);
+
+    // 环形缓冲区：m_head 只由生产者写，m_tail 只由消费者写
+    KeystrokeEvent m_ring[RingCapacity];
+    QAtomicInteger<quint32> m_head;
+    QAtomicInteger<quint32> m_tail;
+    QAtomicInteger<quint32> m_dropped;
+
+    QElapsedTimer m_clock;
+    qint64 m_lastKeyUs; // 生产者私有
+
+    QThread m_thread;
+    AnalyticsWorker* m_worker;
+
+    mutable QMutex m_publishMutex;
+    TypingMetrics m_published;
+};
+
+#endif // TYPINGANALYTICS_H
@@ -0,0 +1,150 @@
+﻿#include "typingribbon.h"
+#include <QFontMetricsF>
+#include <QTextLayout>
+#include <cmath>
+
+const qreal ANCHOR_RATIO = 1.0 / 3.0;  // 光标左边留三分之一给已打的字
+const qreal SCROLL_TAU_MS = 80.0;      // 滚动的时间常数，越小跟得越紧
+const qreal MAX_LAG = 400.0;
+const qint64 MAX_FRAME_MS = 100;       // 暂停、切窗口之后不要一下子跳完
+
+TypingRibbon::TypingRibbon(const QFont& font)
+    : m_caret(0), m_useCounter(0), m_lag(0.0) {
+    setFont(font);
+}
+
+void TypingRibbon::setFont(const QFont& font) {
+    m_font = font;
+    m_ascent = QFontMetricsF(m_font).ascent();
+    m_cache.clear();
+}
+
+void TypingRibbon::setText(const QString& text) {
+    m_text = text;
+    m_caret = 0;
+    m_lag = 0.0;
+    m_cache.clear();
+}
+
+const TypingRibbon::Segment& TypingRibbon::segment(int index) {
+    ++m_useCounter;
+    int victim = 0;
+    for (int i = 0; i < m_cache.size(); ++i) {
+        if (m_cache[i].index == index) {
+            m_cache[i].lastUsed = m_useCounter;
+            return m_cache[i];
+        }
+        if (m_cache[i].lastUsed < m_cache[victim].lastUsed) victim = i;
+    }
+    if (m_cache.size() < CacheSize) {
+        m_cache.append(Segment());
+        victim = m_cache.size() - 1;
+    }
+
+    Segment& s = m_cache[victim];
+    s.index = index;
+    s.start = index * SegmentLength;
+    s.length = qMin(SegmentLength, m_text.size() - s.start);
+    s.lastUsed = m_useCounter;
+
+    const QString part = m_text.mid(s.start, s.length);
+    QTextLayout layout(part, m_font);
+    layout.beginLayout();
+    QTextLine line = layout.createLine();
+    layout.endLayout();
+    s.offsets.resize(s.length + 1);
+    for (int i = 0; i <= s.length; ++i) {
+        s.offsets[i] = line.isValid() ? line.cursorToX(i) : 0.0;
+    }
+    s.text.setTextFormat(Qt::PlainText);
+    s.text.setText(part);
+    return s;
+}
+
+qreal TypingRibbon::distance(int from, int to) {
+    if (from > to) return -distance(to, from);
+    qreal d = 0.0;
+    int pos = from;
+    while (pos < to) {
+        const Segment& s = segment(pos / SegmentLength);
+        const int end = qMin(to, s.start + s.length);
+        d += s.offsets[end - s.start] - s.offsets[pos - s.start];
+        pos = end;
+    }
+    return d;
+}
+
+void TypingRibbon::setCaret(int index) {
+    index = qBound(0, index, m_text.size());
+    if (index == m_caret) return;
+
+    if (qAbs(index - m_caret) <= 2 * SegmentLength) {
+        m_lag = qBound(-MAX_LAG, m_lag + distance(m_caret, index), MAX_LAG);
+    }
+    else {
+        m_lag = 0.0;
+    }
+    m_caret = index;
+}
+
+void TypingRibbon::draw(QPainter& painter, const QRectF& viewport, qreal baselineY,
+    const QColor& typedColor, const QColor& remainColor, const QColor& caretColor) {
+    // 滚动：按真实经过的时间指数衰减，帧率变化时速度不变
+    const qint64 dt = m_clock.isValid() ? qMin(m_clock.restart(), MAX_FRAME_MS) : 0;
+    if (!m_clock.isValid()) m_clock.start();
+    m_lag *= std::exp(-dt / SCROLL_TAU_MS);
+    if (qAbs(m_lag) < 0.05) m_lag = 0.0;
+
+    const qreal caretX = viewport.left() + viewport.width() * ANCHOR_RATIO + m_lag;
+    const qreal top = baselineY - m_ascent;
+
+    painter.save();
+    painter.setClipRect(viewport, Qt::IntersectClip);
+    painter.setFont(m_font);
+
+    if (!m_text.isEmpty()) {
+        // 光标所在段（光标在末尾时取最后一段）的左边缘
+        const int caretSeg = qMin(m_caret / SegmentLength, segmentCount() - 1);
+        const Segment& anchor = segment(caretSeg);
+        const qreal anchorLeft = caretX - anchor.offsets[m_caret - anchor.start];
+
+        auto drawSegment = [&](const Segment& s, qreal left) {
+            const qreal width = s.offsets[s.length];
+            const int end = s.start + s.length;
+            if (end <= m_caret || s.start >= m_caret) {
+                painter.setPen(end <= m_caret ? typedColor : remainColor);
+                painter.drawStaticText(QPointF(left, top), s.text);
+                return width;
+            }
+            // 光标落在段内：按光标位置分两次裁剪绘制
+            const qreal split = left + s.offsets[m_caret - s.start];
+            painter.save();
+            painter.setClipRect(QRectF(left, viewport.top(), split - left, viewport.height()), Qt::IntersectClip);
+            painter.setPen(typedColor);
+            painter.drawStaticText(QPointF(left, top), s.text);
+            painter.restore();
+            painter.save();
+            painter.setClipRect(QRectF(split, viewport.top(), left + width - split, viewport.height()), Qt::IntersectClip);
+            painter.setPen(remainColor);
+            painter.drawStaticText(QPointF(left, top), s.text);
+            painter.restore();
+            return width;
+        };
+
+        // 向右铺到视口外
+        qreal left = anchorLeft;
+        for (int i = caretSeg; i < segmentCount() && left < viewport.right(); ++i) {
+            left += drawSegment(segment(i), left);
+        }
+        // 向左铺到视口外
+        qreal right = anchorLeft;
+        for (int i = caretSeg - 1; i >= 0 && right > viewport.left(); --i) {
+            const Segment& s = segment(i);
+            right -= s.offsets[s.length];
+            drawSegment(s, right);
+        }
+    }
+
+    painter.fillRect(QRectF(caretX, baselineY - 22, 3, 28), caretColor);
+    painter.restore();
+}
@@ -0,0 +1,62 @@
+﻿#ifndef TYPINGRIBBON_H
+#define TYPINGRIBBON_H
+
+#include "gamecore_global.h"
+#include <QElapsedTimer>
+#include <QFont>
+#include <QPainter>
+#include <QStaticText>
+#include <QVector>
+
+// 平滑滚动的打字条
+// 文本按 SegmentLength 个字符分段，只有落在视口附近的段才排版（QTextLayout 求
+// 每个字符的 x，QStaticText 负责绘制），排好的段放在固定大小的缓存里按最近使用淘汰。
+// 不需要整篇的总宽度：以光标所在的段为基准向左右铺开，所以文本多长（整本书）
+// 每帧的开销和内存都不变。光标前进时整条平滑左移，位置是亚像素的。
+class GAMECORE_EXPORT TypingRibbon {
+public:
+    static const int SegmentLength = 32;
+    static const int CacheSize = 16;  // 远大于一屏可见的段数
+
+    explicit TypingRibbon(const QFont& font = QFont());
+
+    void setFont(const QFont& font);
+    // 换文本：光标回到开头，不做滚动动画
+    void setText(const QString& text);
+    const QString& text() const { return m_text; }
+
+    // 光标移到 index；向前后移动不超过两段时平滑滚过去，否则直接跳
+    void setCaret(int index);
+    int caret() const { return m_caret; }
+
+    // 在 viewport 内绘制，光标固定在宽度的 AnchorRatio 处，baselineY 为文字基线
+    void draw(QPainter& painter, const QRectF& viewport, qreal baselineY,
+        const QColor& typedColor, const QColor& remainColor, const QColor& caretColor);
+
+private:
+    struct Segment {
+        int index = -1;            // 第几段，-1 为空位
+        int start = 0;
+        int length = 0;
+        QStaticText text;
+        QVector<qreal> offsets;    // 段内每个字符左侧的 x，多一项为段宽
+        quint64 lastUsed = 0;
+    };
+
+    int segmentCount() const { return (m_text.size() + SegmentLength - 1) / SegmentLength; }
+    const Segment& segment(int index);
+    qreal distance(int from, int to); // from 到 to 的水平距离，to 在前时为正
+
+    QFont m_font;
+    qreal m_ascent;
+    QString m_text;
+    int m_caret;
+
+    QVector<Segment> m_cache;
+    quint64 m_useCounter;
+
+    qreal m_lag;              // 画面落后于目标位置的距离，逐帧衰减到 0
+    QElapsedTimer m_clock;
+};
+
+#endif // TYPINGRIBBON_H